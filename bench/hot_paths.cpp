@@ -0,0 +1,141 @@
+// Micro-benchmarks for the CPU hot paths, run against the checked-in corpus in bench/corpus.
+// Build with -DLEETCLI_BUILD_BENCH=ON and run ./leetcli_bench; besides time per op, every
+// benchmark reports allocs/op and bytes/op from the counting operator new below.
+
+#include "config.h"
+#include "leetcode_api.h"
+#include "utils.h"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+namespace {
+    std::atomic<size_t> allocation_count{0};
+    std::atomic<size_t> allocation_bytes{0};
+}
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    std::string corpus_path(const char* name) {
+        return std::string(LEETCLI_BENCH_CORPUS) + "/" + name;
+    }
+
+    std::string read_corpus(const char* name) {
+        std::ifstream in(corpus_path(name), std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "missing corpus file %s\n", corpus_path(name).c_str());
+            std::exit(1);
+        }
+        std::ostringstream out;
+        out << in.rdbuf();
+        return out.str();
+    }
+
+    // Counts allocations made while the benchmark loop runs
+    class AllocationScope {
+    public:
+        explicit AllocationScope(benchmark::State& state)
+            : state_(state), count_(allocation_count.load()), bytes_(allocation_bytes.load()) {}
+
+        ~AllocationScope() {
+            state_.counters["allocs/op"] = benchmark::Counter(static_cast<double>(allocation_count.load() - count_),
+                                                              benchmark::Counter::kAvgIterations);
+            state_.counters["bytes/op"] = benchmark::Counter(static_cast<double>(allocation_bytes.load() - bytes_),
+                                                             benchmark::Counter::kAvgIterations);
+        }
+
+    private:
+        benchmark::State& state_;
+        size_t count_;
+        size_t bytes_;
+    };
+
+    void BM_HtmlToText(benchmark::State& state) {
+        const std::string html = read_corpus("problem.html");
+        AllocationScope allocations(state);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(leetcli::html_to_text(html));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * html.size()));
+    }
+    BENCHMARK(BM_HtmlToText);
+
+    void BM_LoadTestcases(benchmark::State& state) {
+        const std::string path = corpus_path("testcases_large.txt");
+        const size_t size = read_corpus("testcases_large.txt").size();
+        AllocationScope allocations(state);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(leetcli::load_testcases(path));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    }
+    BENCHMARK(BM_LoadTestcases);
+
+    void BM_ParseConfig(benchmark::State& state) {
+        const std::string text = read_corpus("config.json");
+        AllocationScope allocations(state);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(leetcli::parse_config(nlohmann::json::parse(text)));
+        }
+    }
+    BENCHMARK(BM_ParseConfig);
+
+    // Everything fetch_problem_files does once the response is in: parse, convert and write the folder
+    void BM_FetchResponse(benchmark::State& state) {
+        const std::string text = read_corpus("graphql_question.json");
+        char dir_template[] = "/tmp/leetcli-bench-XXXXXX";
+        if (!mkdtemp(dir_template)) {
+            state.SkipWithError("mkdtemp failed");
+            return;
+        }
+        const std::string problems_dir = dir_template;
+        {
+            AllocationScope allocations(state);
+            for (auto _ : state) {
+                leetcli::FetchResult result = leetcli::save_problem_response("maximum-subsequence-score", text, "cpp", problems_dir);
+                if (!result.ok) {
+                    state.SkipWithError(result.error.c_str());
+                    break;
+                }
+                benchmark::DoNotOptimize(result);
+            }
+        }
+        std::error_code ec;
+        std::filesystem::remove_all(problems_dir, ec);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    }
+    BENCHMARK(BM_FetchResponse);
+
+    void BM_ParseResponseOnly(benchmark::State& state) {
+        const std::string text = read_corpus("graphql_question.json");
+        AllocationScope allocations(state);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(nlohmann::json::parse(text, nullptr, false));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    }
+    BENCHMARK(BM_ParseResponseOnly);
+}
+
+BENCHMARK_MAIN();
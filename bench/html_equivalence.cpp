@@ -0,0 +1,178 @@
+// Checks that html_to_text gives byte-identical output to the regex converter it replaced.
+// Build with -DLEETCLI_BUILD_CHECKS=ON and run ./html_equivalence (or ctest). Inputs are every
+// file in bench/corpus/html plus kGeneratedDocs documents built from a fixed seed.
+//
+// The claim only covers what the regex version already handled: <p>, <br>, <h1>, <h2>, closing
+// </h1>-</h6>, <li>, <b>/<strong>, inline <code>, tags it dropped (div, span, ...) with their
+// attributes, and the five entities &nbsp; &lt; &gt; &amp; &quot;. Output deliberately differs for:
+//   - <pre><code> blocks: the old <p[^>]*> rule ate <pre> first, so the fence never opened
+//     and a stray "</code></pre>" closed one that wasn't there
+//   - <h3>-<h6>, <ol>, nested lists, <em>/<i>, <sup>/<sub>, <img>, tables and comments, which
+//     the old version dropped or mangled
+//   - numeric and other named entities, which it left encoded, and "&amp;quot;", which it
+//     decoded twice
+//   - a bare '<' in text and '>' inside a quoted attribute, where [^>]* cut the tag short
+// Corpus files using any of these are rejected rather than compared.
+
+#include "utils.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int kGeneratedDocs = 300;
+    constexpr unsigned kSeed = 20261017;
+
+    // src/utils.cpp before the single-pass converter, unchanged
+    std::string legacy_html_to_text(const std::string &html) {
+        std::string text = html;
+        text = std::regex_replace(text, std::regex("<h1[^>]*>"), "# ");
+        text = std::regex_replace(text, std::regex("<h2[^>]*>"), "## ");
+        text = std::regex_replace(text, std::regex("</h[1-6]>"), "\n");
+        text = std::regex_replace(text, std::regex("<p[^>]*>"), "\n");
+        text = std::regex_replace(text, std::regex("</p>"), "\n");
+        text = std::regex_replace(text, std::regex("<br[^>]*>"), "\n");
+        text = std::regex_replace(text, std::regex("<li[^>]*>"), " - ");
+        text = std::regex_replace(text, std::regex("</li>"), "\n");
+        text = std::regex_replace(text, std::regex("<pre[^>]*><code[^>]*>"), "```\n");
+        text = std::regex_replace(text, std::regex("</code></pre>"), "\n```");
+        text = std::regex_replace(text, std::regex("<code[^>]*>"), "`");
+        text = std::regex_replace(text, std::regex("</code>"), "`");
+        text = std::regex_replace(text, std::regex("<b[^>]*>"), "**");
+        text = std::regex_replace(text, std::regex("</b>"), "**");
+        text = std::regex_replace(text, std::regex("<strong[^>]*>"), "**");
+        text = std::regex_replace(text, std::regex("</strong>"), "**");
+        text = std::regex_replace(text, std::regex("<[^>]*>"), "");
+
+        text = std::regex_replace(text, std::regex("&nbsp;"), " ");
+        text = std::regex_replace(text, std::regex("&lt;"), "<");
+        text = std::regex_replace(text, std::regex("&gt;"), ">");
+        text = std::regex_replace(text, std::regex("&amp;"), "&");
+        text = std::regex_replace(text, std::regex("&quot;"), "\"");
+
+        return text;
+    }
+
+    // Why a document falls outside the equivalence claim, or "" when it doesn't
+    std::string excluded_construct(const std::string& html) {
+        static const std::regex tag_re("<(/?)([a-zA-Z][a-zA-Z0-9]*)[^>]*>");
+        static const std::vector<std::string> allowed = {"p", "br", "h1", "h2", "li", "ul", "b", "strong", "code", "div", "span", "pre"};
+        int list_depth = 0;
+        for (auto it = std::sregex_iterator(html.begin(), html.end(), tag_re); it != std::sregex_iterator(); ++it) {
+            std::string name = (*it)[2];
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+            bool closing = (*it)[1].length() > 0;
+            bool heading = name.size() == 2 && name[0] == 'h' && name[1] >= '3' && name[1] <= '6';
+            if (heading && closing) continue;
+            if (std::find(allowed.begin(), allowed.end(), name) == allowed.end()) return "<" + name + ">";
+            if (name == "ul" && (list_depth += closing ? -1 : 1) > 1) return "nested lists";
+        }
+        if (html.find("<pre><code") != std::string::npos || html.find("</code></pre>") != std::string::npos) return "<pre><code>";
+        if (html.find("<!") != std::string::npos) return "comments";
+        if (html.find("&amp;quot;") != std::string::npos) return "&amp;quot;";
+
+        static const std::regex entity_re("&([a-zA-Z0-9#]+);");
+        for (auto it = std::sregex_iterator(html.begin(), html.end(), entity_re); it != std::sregex_iterator(); ++it) {
+            std::string name = (*it)[1];
+            if (name != "nbsp" && name != "lt" && name != "gt" && name != "amp" && name != "quot") return "&" + name + ";";
+        }
+        for (size_t i = html.find('<'); i != std::string::npos; i = html.find('<', i + 1)) {
+            size_t end = html.find('>', i);
+            if (end == std::string::npos || html.find('<', i + 1) < end) return "bare '<'";
+            std::string tag = html.substr(i, end - i);
+            if (std::count(tag.begin(), tag.end(), '"') % 2) return "'>' inside an attribute";
+        }
+        return "";
+    }
+
+    // Random mixes of the constructs both versions handle, including unbalanced and misnested tags
+    std::string generated_doc(std::mt19937& rng) {
+        static const std::vector<std::string> tokens = {
+            "<p>", "</p>", "<p class=\"a\">", "<br>", "<br/>", "<br />", "<h1>", "</h1>", "<h2>", "</h2>",
+            "</h3>", "<li>", "</li>", "<b>", "</b>", "<strong>", "</strong>", "<code>", "</code>",
+            "<div class=\"a\">", "</div>", "<span>", "</span>", "<pre>", "</pre>",
+            "&nbsp;", "&lt;", "&gt;", "&amp;", "&quot;", "x", "text ", "nums[i] ", "x = 1\n", "\n", " ",
+        };
+        std::uniform_int_distribution<size_t> pick(0, tokens.size() - 1);
+        std::uniform_int_distribution<int> length(1, 120);
+
+        std::string doc;
+        std::string previous;
+        for (int n = length(rng); n > 0; --n) {
+            const std::string& token = tokens[pick(rng)];
+            // Adjacent <pre><code> and </code></pre> are the constructs whose output changed
+            if ((previous == "<pre>" && token == "<code>") || (previous == "</code>" && token == "</pre>")) continue;
+            doc += token;
+            previous = token;
+        }
+        return doc;
+    }
+
+    bool read_file(const std::filesystem::path& path, std::string& out) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        out = ss.str();
+        return true;
+    }
+
+    void print_difference(const std::string& name, const std::string& expected, const std::string& actual) {
+        size_t at = std::mismatch(expected.begin(), expected.end(), actual.begin(), actual.end()).first - expected.begin();
+        size_t from = at > 40 ? at - 40 : 0;
+        std::printf("DIFF %s at byte %zu\n  old: %s\n  new: %s\n", name.c_str(), at,
+                    expected.substr(from, 80).c_str(), actual.substr(from, 80).c_str());
+    }
+}
+
+int main() {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(LEETCLI_HTML_CORPUS)) {
+        if (entry.path().extension() == ".html") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    int failures = 0;
+    int compared = 0;
+    for (const auto& path : files) {
+        std::string html;
+        if (!read_file(path, html)) {
+            std::printf("FAIL %s: unreadable\n", path.filename().c_str());
+            ++failures;
+            continue;
+        }
+        if (std::string reason = excluded_construct(html); !reason.empty()) {
+            std::printf("FAIL %s uses %s, which is outside the equivalence claim\n", path.filename().c_str(), reason.c_str());
+            ++failures;
+            continue;
+        }
+        std::string expected = legacy_html_to_text(html);
+        std::string actual = leetcli::html_to_text(html);
+        ++compared;
+        if (expected != actual) {
+            print_difference(path.filename().string(), expected, actual);
+            ++failures;
+        }
+    }
+
+    std::mt19937 rng(kSeed);
+    for (int i = 0; i < kGeneratedDocs; ++i) {
+        std::string html = generated_doc(rng);
+        std::string expected = legacy_html_to_text(html);
+        std::string actual = leetcli::html_to_text(html);
+        ++compared;
+        if (expected != actual) {
+            print_difference("generated #" + std::to_string(i), expected, actual);
+            ++failures;
+        }
+    }
+
+    std::printf("%d documents compared (%zu corpus, %d generated), %d failed\n", compared, files.size(), kGeneratedDocs, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+// Checks the streaming path behind `hint`. Build with -DLEETCLI_BUILD_CHECKS=ON and run ./sse_stream
+// (or ctest). Covers:
+//   - SseParser on the same body fed whole, split at every byte offset and one byte at a time,
+//     with LF and CRLF line endings: comments, event:/id: lines, multi-line data, "[DONE]" and a
+//     last event with no blank line after it
+//   - decode_stream_event on text, "[DONE]", error and malformed events
+//   - gemini_stream end to end (POSIX only) against a one-shot stub server reached through
+//     LEETCLI_GEMINI_ENDPOINT, which sends its chunked body in small pieces that cut frames,
+//     JSON and CRLF pairs apart
+
+#include "gemini.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <chrono>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const std::string& what) {
+        if (ok) return;
+        std::printf("FAIL %s\n", what.c_str());
+        ++failures;
+    }
+
+    std::string with_crlf(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '\n') out += '\r';
+            out += c;
+        }
+        return out;
+    }
+
+    // Feeds body to a fresh parser in the pieces between the cut offsets
+    std::vector<std::string> parse_in_pieces(std::string_view body, const std::vector<size_t>& cuts) {
+        std::vector<std::string> events;
+        leetcli::SseParser parser([&](const std::string& data) { events.push_back(data); });
+        size_t from = 0;
+        for (size_t cut : cuts) {
+            parser.feed(body.substr(from, cut - from));
+            from = cut;
+        }
+        parser.feed(body.substr(from));
+        parser.finish();
+        return events;
+    }
+
+    void check_parser() {
+        const std::string body =
+            ": keep-alive\n"
+            "\n"
+            "data: {\"a\":1}\n"
+            "\n"
+            "event: message\n"
+            "id: 7\n"
+            "data: first line\n"
+            "data:second line\n"
+            "\n"
+            "data: [DONE]\n"
+            "\n"
+            "data: tail without a blank line";
+        const std::vector<std::string> expected = {"{\"a\":1}", "first line\nsecond line", "[DONE]", "tail without a blank line"};
+
+        for (const auto& [name, text] : {std::pair<std::string, std::string>{"LF", body}, {"CRLF", with_crlf(body)}}) {
+            check(parse_in_pieces(text, {}) == expected, name + " body in one piece");
+            for (size_t i = 1; i < text.size(); ++i) {
+                check(parse_in_pieces(text, {i}) == expected, name + " body split at byte " + std::to_string(i));
+            }
+            std::vector<size_t> every_byte;
+            for (size_t i = 1; i < text.size(); ++i) every_byte.push_back(i);
+            check(parse_in_pieces(text, every_byte) == expected, name + " body one byte at a time");
+        }
+    }
+
+    void check_decoder() {
+        auto decode = [](const std::string& data, std::vector<std::string>& pieces, std::string& error) {
+            pieces.clear();
+            error.clear();
+            leetcli::decode_stream_event(data, [&](const std::string& piece) { pieces.push_back(piece); }, error);
+        };
+        std::vector<std::string> pieces;
+        std::string error;
+
+        decode(R"({"candidates":[{"content":{"parts":[{"text":"Try "},{"text":""},{"text":"a map"}],"role":"model"}}]})", pieces, error);
+        check(pieces == std::vector<std::string>{"Try ", "a map"} && error.empty(), "text event");
+
+        decode("[DONE]", pieces, error);
+        check(pieces.empty() && error.empty(), "[DONE] event");
+
+        decode(R"({"error":{"code":429,"message":"Resource has been exhausted","status":"RESOURCE_EXHAUSTED"}})", pieces, error);
+        check(pieces.empty() && error == "Resource has been exhausted", "error event");
+
+        decode(R"({"error":"boom"})", pieces, error);
+        check(error == "boom", "error event with a bare string");
+
+        for (const char* malformed : {R"({"candidates":[{"content":"x"}]})", R"({"candidates":[1]})",
+                                      R"({"candidates":[{"content":{"parts":[1,{"text":2}]}}]})", "{\"candidates\":"}) {
+            decode(malformed, pieces, error);
+            check(pieces.empty() && error.empty(), std::string("malformed event ") + malformed);
+        }
+    }
+
+#ifndef _WIN32
+    // Answers one request with a chunked event-stream body, writing each piece separately
+    void serve_once(int listener, const std::vector<std::string>& pieces, std::string& request_line) {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) return;
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        std::string request;
+        char buf[4096];
+        size_t header_end = std::string::npos;
+        size_t body_length = 0;
+        while (header_end == std::string::npos || request.size() < header_end + 4 + body_length) {
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n <= 0) break;
+            request.append(buf, static_cast<size_t>(n));
+            if (header_end == std::string::npos && (header_end = request.find("\r\n\r\n")) != std::string::npos) {
+                std::string headers = request.substr(0, header_end);
+                for (auto& c : headers) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                if (size_t at = headers.find("content-length:"); at != std::string::npos) {
+                    body_length = std::strtoul(headers.c_str() + at + 15, nullptr, 10);
+                }
+                if (headers.find("expect: 100-continue") != std::string::npos) {
+                    const std::string go_on = "HTTP/1.1 100 Continue\r\n\r\n";
+                    (void)!write(fd, go_on.data(), go_on.size());
+                }
+            }
+        }
+        request_line = request.substr(0, request.find("\r\n"));
+
+        std::string head = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nTransfer-Encoding: chunked\r\n\r\n";
+        (void)!write(fd, head.data(), head.size());
+        for (const auto& piece : pieces) {
+            char size[16];
+            std::snprintf(size, sizeof(size), "%zx\r\n", piece.size());
+            std::string chunk = size + piece + "\r\n";
+            (void)!write(fd, chunk.data(), chunk.size());
+            // Long enough that the client reads each piece on its own
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        (void)!write(fd, "0\r\n\r\n", 5);
+        close(fd);
+    }
+
+    // body cut every `every` bytes and right after the first '\r', so one cut lands inside a CRLF
+    std::vector<std::string> awkward_pieces(const std::string& body, size_t every) {
+        std::vector<size_t> cuts;
+        for (size_t i = every; i < body.size(); i += every) cuts.push_back(i);
+        if (size_t cr = body.find('\r'); cr != std::string::npos) cuts.push_back(cr + 1);
+        std::sort(cuts.begin(), cuts.end());
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+        std::vector<std::string> pieces;
+        size_t from = 0;
+        for (size_t cut : cuts) {
+            pieces.push_back(body.substr(from, cut - from));
+            from = cut;
+        }
+        pieces.push_back(body.substr(from));
+        return pieces;
+    }
+
+    void check_stream(int listener) {
+        nlohmann::json payload = {{"contents", {{{"parts", {{{"text", "hint please"}}}}}}}};
+        leetcli::GeminiOptions options;
+        options.use_cache = false;
+
+        const std::string body = with_crlf(
+            "data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"Try \"}],\"role\":\"model\"}}]}\n\n"
+            ": ping\n\n"
+            "data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"a hash map.\"}],\"role\":\"model\"}}]}\n\n"
+            "data: [DONE]\n\n");
+        std::string request_line;
+        std::thread server(serve_once, listener, awkward_pieces(body, 7), std::ref(request_line));
+        std::vector<std::string> pieces;
+        std::string error;
+        leetcli::GeminiStreamStats stats;
+        auto text = leetcli::gemini_stream(payload, [&](std::string_view piece) { pieces.emplace_back(piece); },
+                                           error, options, &stats);
+        server.join();
+        check(text && *text == "Try a hash map.", "streamed text (error: " + error + ")");
+        check(pieces == std::vector<std::string>{"Try ", "a hash map."}, "streamed pieces");
+        check(stats.first_token.has_value() && !stats.from_cache && !stats.cancelled, "stream stats");
+        check(request_line.rfind("POST /v1beta/models/", 0) == 0 &&
+              request_line.find(":streamGenerateContent?alt=sse&key=test-key ") != std::string::npos,
+              "request line " + request_line);
+
+        const std::string error_body =
+            "data: {\"error\":{\"code\":429,\"message\":\"Resource has been exhausted\",\"status\":\"RESOURCE_EXHAUSTED\"}}\n\n";
+        server = std::thread(serve_once, listener, awkward_pieces(error_body, 5), std::ref(request_line));
+        error.clear();
+        text = leetcli::gemini_stream(payload, [](std::string_view) {}, error, options);
+        server.join();
+        check(!text && error == "Gemini reported an error: Resource has been exhausted", "error event, got: " + error);
+    }
+
+    void check_stream_end_to_end() {
+        int listener = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            listen(listener, 1) != 0 || getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            check(false, "stub server could not listen on 127.0.0.1");
+            return;
+        }
+
+        // A throwaway home with just a Gemini key, so the user's config and cache are never touched
+        char home_template[] = "/tmp/leetcli-sse-XXXXXX";
+        if (!mkdtemp(home_template)) {
+            check(false, "mkdtemp");
+            close(listener);
+            return;
+        }
+        std::filesystem::path home = home_template;
+        std::filesystem::create_directories(home / ".leetcli");
+        std::ofstream(home / ".leetcli/config.json") << R"({"gemini_key": "test-key", "lang": "cpp", "problems_dir": "problems"})";
+        setenv("HOME", home.c_str(), 1);
+        std::string endpoint = "http://127.0.0.1:" + std::to_string(ntohs(addr.sin_port)) + "/v1beta";
+        setenv("LEETCLI_GEMINI_ENDPOINT", endpoint.c_str(), 1);
+
+        check_stream(listener);
+
+        close(listener);
+        std::error_code ec;
+        std::filesystem::remove_all(home, ec);
+    }
+#endif
+}
+
+int main() {
+    check_parser();
+    check_decoder();
+#ifndef _WIN32
+    check_stream_end_to_end();
+#endif
+    std::printf("%s, %d failed\n", failures ? "FAILED" : "OK", failures);
+    return failures ? 1 : 0;
+}
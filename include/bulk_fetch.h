@@ -0,0 +1,33 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace leetcli {
+    struct BulkFetchOptions {
+        int jobs = 8;
+        bool force = false;          // refetch problems that are already on disk
+        bool include_paid = false;   // only matters for --tag lists
+        bool quiet = false;          // no per-problem progress lines
+        std::string lang_override;
+    };
+
+    struct BulkFetchSummary {
+        size_t fetched = 0;
+        size_t skipped = 0;
+        std::vector<std::pair<std::string, std::string>> failures; // slug, reason
+        double seconds = 0;
+    };
+
+    // One slug per line; blank lines, '#' comments and full problem URLs are accepted
+    std::vector<std::string> read_slug_list(std::istream& in);
+    // Sets error and returns the pages listed so far if a page request fails
+    std::vector<std::string> fetch_tag_slugs(const std::string& tag, bool include_paid, std::string& error);
+    bool is_problem_materialized(const std::string& slug);
+
+    BulkFetchSummary fetch_many(const std::vector<std::string>& slugs, const BulkFetchOptions& options);
+    void print_bulk_summary(const BulkFetchSummary& summary);
+    // Non-zero if anything failed: a bad argument or list, a tag lookup, or any single problem
+    int handle_fetch_many_command(const std::vector<std::string>& args);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    struct CatalogEntry {
+        std::string frontend_id;
+        std::string slug;
+        std::string title;
+        std::string difficulty;
+        double acceptance = 0;        // percent
+        bool paid_only = false;
+        std::vector<std::string> tags; // topic tag slugs
+    };
+
+    struct CatalogFilter {
+        std::string difficulty;
+        std::vector<std::string> tags;  // all must match
+        std::optional<double> min_acceptance;
+        std::optional<double> max_acceptance;
+        std::optional<bool> paid_only;
+        std::string title_contains;
+        size_t limit = 50;
+    };
+
+    // Local mirror of the problem list in ~/.leetcli/catalog.tsv
+    std::vector<CatalogEntry> load_catalog();
+    // Incremental by default: only the last known page onwards, since new problems are appended.
+    // Stats of earlier problems (acceptance, tags, paid flag) only change on a full pass, so one is
+    // forced when the last was over a week ago. full=true refreshes every page now.
+    bool sync_catalog(bool full);
+    std::vector<CatalogEntry> query_catalog(const std::vector<CatalogEntry>& catalog, const CatalogFilter& filter);
+
+    void handle_catalog_command(const std::vector<std::string>& args);
+    void handle_problems_command(const std::vector<std::string>& args);
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    // Runs one CLI command; args[0] is the command name. Returns the process exit code.
+    int run_command(const std::vector<std::string>& args);
+
+    // Commands that never read stdin or need the caller's terminal, so leetclid may run them
+    bool runs_in_daemon(const std::vector<std::string>& args);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace leetcli {
+    // Everything in ~/.leetcli/config.json, parsed once per process
+    struct Config {
+        std::string problems_dir;
+        std::string lang = "cpp";
+        std::string leetcode_session;
+        std::string csrf_token;
+        std::string gemini_key;
+        int gemini_cache_ttl_hours = 168; // 0 disables the Gemini response cache
+        int gemini_cache_max_mb = 20;
+        nlohmann::json raw = nlohmann::json::object(); // keeps keys we don't model so saving never drops them
+    };
+
+    std::filesystem::path get_config_path();
+    bool config_exists();
+
+    // Throws std::runtime_error describing the first invalid field
+    Config parse_config(const nlohmann::json& json);
+
+    // Loaded and validated on first use; throws std::runtime_error with a hint to run `leetcli init`
+    // if missing or invalid
+    const Config& config();
+
+    // Long-lived processes (leetclid) call this between commands to pick up edits made elsewhere
+    void refresh_config();
+
+    // The only way config.json gets written: temp file + rename, then the in-process copy is updated
+    bool save_config(const Config& updated);
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    // ~/.leetcli/leetclid.sock
+    std::filesystem::path daemon_socket_path();
+
+    // Sends the command to a running leetclid and relays its output as it comes. Returns the
+    // command's exit code, or nullopt when no daemon is listening so the caller runs it itself.
+    std::optional<int> forward_to_daemon(const std::vector<std::string>& args);
+
+    // leetclid's main loop: serves each client on its own thread with warm config, metadata and HTTP
+    // connections until `leetcli daemon stop`, SIGINT or SIGTERM. POSIX only.
+    int run_daemon();
+
+    // leetcli daemon start|stop|status
+    int handle_daemon_command(const std::vector<std::string>& args);
+}
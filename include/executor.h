@@ -0,0 +1,85 @@
+#pragma once
+#include "request_context.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace leetcli {
+    namespace detail {
+        template <typename T>
+        struct TaskState {
+            template <typename F>
+            explicit TaskState(F&& fn) : work(std::forward<F>(fn)) {}
+
+            // Whoever gets here first runs the work: a pool worker or the thread waiting on it
+            void run() {
+                if (!claimed.exchange(true)) work();
+            }
+
+            std::atomic<bool> claimed{false};
+            std::packaged_task<T()> work;
+        };
+    }
+
+    // What Executor::submit returns. Waiting on a task no worker has picked up yet runs it on the
+    // waiting thread, so a task that submits more tasks and waits for them can't starve the pool.
+    template <typename T>
+    class Task {
+    public:
+        explicit Task(std::shared_ptr<detail::TaskState<T>> state) : state_(std::move(state)), result_(state_->work.get_future()) {}
+
+        // Rethrows whatever the task threw
+        T get() {
+            state_->run();
+            return result_.get();
+        }
+
+    private:
+        std::shared_ptr<detail::TaskState<T>> state_;
+        std::future<T> result_;
+    };
+
+    // A fixed set of worker threads that commands hand independent work to. Tasks carry the
+    // submitting thread's leetclid request along, so their output reaches the same client.
+    class Executor {
+    public:
+        explicit Executor(unsigned threads);
+        ~Executor();
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+
+        template <typename F>
+        auto submit(F&& fn) {
+            using T = std::invoke_result_t<std::decay_t<F>&>;
+            auto state = std::make_shared<detail::TaskState<T>>(
+                [request = current_request(), fn = std::forward<F>(fn)]() mutable {
+                    RequestScope scope(request);
+                    return fn();
+                });
+            Task<T> task(state);
+            post([state] { state->run(); });
+            return task;
+        }
+
+    private:
+        void post(std::function<void()> job);
+        void work();
+
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<std::function<void()>> queue_;
+        bool stopping_ = false;
+        std::vector<std::thread> workers_;
+    };
+
+    // The process-wide pool every command shares, leetclid's concurrent clients included
+    Executor& shared_executor();
+}
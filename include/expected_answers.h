@@ -0,0 +1,46 @@
+#pragma once
+#include "leetcode_api.h"
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace leetcli {
+    // Judge answers harvested from remote runs, kept in <problem>/expected_answers.json
+    // and keyed by a hash of the normalized testcase input
+    class ExpectedAnswers {
+    public:
+        bool load(const std::string& folder_path);
+        // Writes the answers harvested since load(), merged into whatever the file holds by then
+        bool save() const;
+
+        std::optional<std::string> find(const std::string& input) const;
+        bool known(const std::vector<std::string>& cases) const;
+        // Every case has a saved answer and the judge compares this problem's output byte for byte
+        // (no any-order or float answers), so a local string compare gives LeetCode's verdict
+        bool exact(const std::vector<std::string>& cases) const;
+
+        // Records expected outputs from a successful remote run; returns how many were new
+        size_t harvest(const RunReport& report);
+        // Fills in expected for rows that have a known answer; rows only get a verdict (judged/passed)
+        // when the problem's answers compare exactly, the rest stay unjudged
+        void judge(RunReport& report) const;
+
+    private:
+        struct Answer {
+            std::string input;
+            std::string expected;
+            bool inexact = false;   // LeetCode accepted output that differs from expected
+        };
+        const Answer* lookup(const std::string& input) const;
+        // From problem.json: false for any-order answers, float returns, or a missing statement
+        bool exact_checker_ = false;
+        // Any case accepted with output that differs from the expected text: some checker the
+        // statement didn't give away, so no case of the problem can be judged locally
+        bool inexact_ = false;
+        std::string path_;
+        std::unordered_map<std::string, Answer> answers_;
+        std::unordered_set<std::string> changed_; // keys harvest() added or updated since load()
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace leetcli {
+    struct GeminiOptions {
+        bool use_cache = true;
+        bool verbose = false; // print time-to-first-token and total time
+    };
+
+    struct GeminiStreamStats {
+        std::optional<std::chrono::milliseconds> first_token; // unset if no text arrived
+        std::chrono::milliseconds total{0};
+        bool from_cache = false;
+        bool cancelled = false;
+    };
+
+    // Incremental parser for text/event-stream bodies. feed() takes bytes as they arrive, split
+    // anywhere; on_event gets the joined data: lines of every complete event.
+    class SseParser {
+    public:
+        explicit SseParser(std::function<void(const std::string&)> on_event);
+        void feed(std::string_view bytes);
+        void finish(); // flushes a final event that wasn't followed by a blank line
+
+    private:
+        void handle_line(std::string_view line);
+
+        std::function<void(const std::string&)> on_event_;
+        std::string line_;
+        std::string data_;
+        bool has_data_ = false;
+    };
+
+    // One event of a streamGenerateContent stream: each non-empty text part goes to on_text, an error
+    // event sets error. Payloads that aren't a JSON object, such as a "[DONE]" marker, are skipped.
+    void decode_stream_event(const std::string& data, const std::function<void(const std::string&)>& on_text,
+                             std::string& error);
+
+    // POSTs a generateContent payload and returns the first candidate's text.
+    // Responses are cached in ~/.leetcli/cache/gemini keyed on model + payload, so asking
+    // again about an unchanged solution is answered from disk.
+    std::optional<std::string> gemini_generate(const nlohmann::json& payload, std::string& error,
+                                               const GeminiOptions& options = {});
+
+    // Same, but through streamGenerateContent: on_text gets each piece of text as it arrives.
+    // Ctrl-C cancels the stream (stats.cancelled). Shares the cache with gemini_generate.
+    std::optional<std::string> gemini_stream(const nlohmann::json& payload,
+                                             const std::function<void(std::string_view)>& on_text,
+                                             std::string& error, const GeminiOptions& options = {},
+                                             GeminiStreamStats* stats = nullptr);
+}
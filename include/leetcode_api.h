@@ -1,20 +1,99 @@
 #pragma once
+#include "gemini.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace leetcli {
+    struct TestCaseResult {
+        std::string input;
+        std::string output;
+        std::string expected;
+        std::string std_output;
+        bool passed = false;
+        bool judged = true; // false when there was no expected answer to compare against
+    };
+
+    // Outcome of one run of the solution against a set of testcases
+    struct RunReport {
+        bool ok = false;
+        std::string status_msg;
+        std::string compile_error;
+        std::string runtime_error;
+        std::string runtime = "N/A";
+        std::string memory = "N/A";
+        std::string lang;
+        std::chrono::milliseconds waited{0}; // time spent waiting on the judge
+        bool cached = false; // replayed from the result cache, the judge wasn't asked
+        std::vector<TestCaseResult> cases;
+    };
+
+    struct RunOptions {
+        bool local = false; // compile and run C++ solutions on this machine
+        bool remote = false; // always ask LeetCode, even when every expected answer is known
+        bool quiet = false; // no progress lines or report; the caller prints the returned RunReport
+        const std::atomic<bool>* cancel = nullptr; // set from another thread to abandon the run
+    };
+
+    struct FetchResult {
+        bool ok = false;
+        std::string question_id;
+        std::string title;
+        std::string markdown;
+        std::string folder_path;
+        std::string error;
+        bool has_testcases = false;
+    };
+
     std::string get_daily_question_slug();
-    std::string fetch_problem(const std::string& slug, const std::string& lang_override);
+    // Writes the problem folder without printing anything; safe to call from several threads
+    FetchResult fetch_problem_files(const std::string& slug, const std::string& lang_override);
+    // fetch_problem_files after the request: turns a getQuestionDetail response into a problem
+    // folder under problems_dir. Touches neither the network nor the metadata cache.
+    FetchResult save_problem_response(const std::string& slug, const std::string& response_text,
+                                      const std::string& lang_override, const std::string& problems_dir);
+    // The saved problem.json as a FetchResult, or nullopt if the problem hasn't been fetched
+    std::optional<FetchResult> load_fetched_problem(const std::string& slug, const std::string& lang_override);
+    std::string fetch_problem(const std::string& slug, const std::string& lang_override, bool force = false);
     std::string read_question_id_from_readme(const std::string& path);
     void solve_problem(const std::string& slug, const std::string &lang_override);
-    void list_fetched_problems();
-    void run_tests(const std::string& slug, const std::string &lang_override);
-    void run_problem(const std::string& slug, const std::string& lang, const std::string& question_id,
-    const std::string& code, const std::string& test_input, const std::string& session, const std::string& csrf);
-    void submit_solution(const std::string& slug, const std::string &lang_override);
+    RunReport run_tests(const std::string& slug, const std::string &lang_override, const RunOptions& options = {});
+    RunReport run_problem(const std::string& slug, const std::string& lang, const std::string& question_id,
+    const std::string& code, const std::vector<std::string>& cases, const RunOptions& options = {});
+    void print_run_report(const RunReport& report);
+    // run --lang=all: every solution.* in the folder against the same testcases, side by side
+    void run_language_matrix(const std::string& slug, const RunOptions& options = {});
+    void submit_solution(const std::string& slug, const std::string &lang_override, bool force = false);
+
+    // The steps of submit_solution, for callers that submit several problems at once
+    struct PreparedSubmission {
+        std::string slug;
+        std::string lang;
+        std::string question_id;
+        std::string code;
+        std::string cache_key;   // for lookup_submission / store_submission
+        std::string folder_path;
+    };
+
+    struct SubmitPost {
+        long status_code = 0;
+        std::string submission_id; // empty on failure
+        std::string error;
+        std::string body;          // response text, for error output
+    };
+
+    // nullopt with an empty error when the problem was already reported (e.g. no solution file)
+    std::optional<PreparedSubmission> prepare_submission(const std::string& slug, const std::string& lang_override,
+                                                         std::string& error);
+    SubmitPost post_submission(const PreparedSubmission& prepared);
+    // Caches the verdict and records it in the manifest
+    void record_verdict(const PreparedSubmission& prepared, const std::string& submission_id, const nlohmann::json& result);
     void handle_config_command(const std::vector<std::string>& args);
-    void analyze_runtime(const std::string& slug, const std::string &lang_override);
-    void give_hint(const std::string& slug, const std::string &lang_override);
+    void analyze_runtime(const std::string& slug, const std::string &lang_override, const GeminiOptions& options = {});
+    void give_hint(const std::string& slug, const std::string &lang_override, const GeminiOptions& options = {});
     void fetch_problem_topics(const std::string &slug);
     void fetch_problem_hints(const std::string &slug);
 }
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <cpr/cpr.h>
+#include <nlohmann/json.hpp>
+
+namespace leetcli {
+    enum class Auth { None, Session };
+
+    // All HTTP traffic goes through here. Each thread gets its own client, but every client
+    // shares one curl share handle, so DNS, TLS sessions and open connections are reused
+    // across requests instead of paying a handshake per call.
+    class LeetCodeClient {
+    public:
+        LeetCodeClient();
+
+        cpr::Response graphql(const nlohmann::json& query, Auth auth = Auth::None, const std::string& referer = "");
+        cpr::Response post_json(const std::string& url, const std::string& body, Auth auth, const std::string& referer = "");
+        cpr::Response get(const std::string& url, Auth auth, const std::string& referer = "");
+
+        // For non-LeetCode hosts (Gemini): same connection pool, none of the LeetCode headers or cookies
+        cpr::Response post_external(const std::string& url, const std::string& body);
+
+    private:
+        cpr::Header leetcode_headers(Auth auth, const std::string& referer);
+        void configure(cpr::Session& session);
+        void apply_rate_limit();
+
+        // GET and POST use separate sessions: cpr keeps a POST body around and would send it with the next GET
+        cpr::Session get_session_;
+        cpr::Session post_session_;
+        std::int64_t rate_limit_ = 0; // what the sessions are currently set to
+    };
+
+    LeetCodeClient& client();
+
+    // Caps each transfer at bytes_per_sec in both directions (0 = unlimited). Applies to every
+    // client, including ones already created; prefetch uses it to stay out of the way.
+    void set_transfer_rate_limit(std::int64_t bytes_per_sec);
+}
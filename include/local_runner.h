@@ -0,0 +1,21 @@
+#pragma once
+#include "leetcode_api.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    struct LocalRunOptions {
+        std::chrono::milliseconds cpu_limit{2000}; // per case, like the judge's TLE
+        size_t memory_limit_mb = 512;              // address space per case; MLE past this
+        unsigned jobs = 0;                         // 0 = one per core
+        const std::atomic<bool>* cancel = nullptr; // kills the cases still running once set
+    };
+
+    // Wraps a C++ solution in a harness generated from problem.json's metaData, compiles it once
+    // (cached under ~/.leetcli/cache/local) and runs every case in its own rlimited child process.
+    // POSIX only.
+    RunReport run_local(const std::string& folder_path, const std::string& solution_path,
+                        const std::vector<std::string>& cases, const LocalRunOptions& options = {});
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    // One row of <problems_dir>/.leetcli/manifest.json
+    struct ManifestEntry {
+        std::string folder;
+        std::string slug;
+        std::string id;             // frontend id, as shown on the website
+        std::string title;
+        std::string difficulty;
+        std::vector<std::string> languages;
+        int64_t folder_mtime = 0;
+        std::string last_run_status;
+        int64_t last_run_at = 0;    // unix seconds
+        std::string last_submit_status;
+        int64_t last_submit_at = 0;
+        bool accepted = false;      // stays set once any submission was accepted
+    };
+
+    // Rescans the given problem folders (after fetch / fetch-many)
+    void update_manifest(const std::vector<std::string>& folder_paths);
+    void record_run_status(const std::string& folder_path, const std::string& status);
+    void record_submit_status(const std::string& folder_path, const std::string& status);
+
+    // Loads the manifest, rescanning folders whose mtime moved (every folder when force_scan)
+    std::vector<ManifestEntry> load_manifest(bool force_scan);
+
+    void handle_list_command(const std::vector<std::string>& args);
+}
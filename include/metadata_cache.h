@@ -0,0 +1,39 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    // What we need to know about a problem to find it on disk and talk to the judge.
+    struct QuestionMeta {
+        std::string question_id;
+        std::string title;
+        std::string folder; // folder name inside the problems dir, e.g. "1. Two Sum"
+    };
+
+    std::string make_folder_name(const std::string& question_id, const std::string& title);
+
+    // Cached lookups, persisted in ~/.leetcli/cache/metadata.json
+    std::optional<QuestionMeta> lookup_question_meta(const std::string& slug);
+    void store_question_meta(const std::string& slug, const QuestionMeta& meta);
+    bool invalidate_question_meta(const std::string& slug);
+    void clear_metadata_cache();
+
+    // Holds metadata.json writes back while alive and writes once at the end (bulk fetches)
+    class MetadataWriteBatch {
+    public:
+        MetadataWriteBatch();
+        ~MetadataWriteBatch();
+        MetadataWriteBatch(const MetadataWriteBatch&) = delete;
+        MetadataWriteBatch& operator=(const MetadataWriteBatch&) = delete;
+    };
+
+    // Cache first, LeetCode GraphQL on a miss. Returns 0 on success like the other path helpers.
+    int resolve_question_meta(const std::string& slug, QuestionMeta& meta);
+
+    // Daily question slug, memoized per UTC day in ~/.leetcli/cache/daily.json
+    std::optional<std::string> lookup_daily_slug();
+    void store_daily_slug(const std::string& slug);
+
+    void handle_cache_command(const std::vector<std::string>& args);
+}
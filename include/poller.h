@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <cpr/cpr.h>
+#include <nlohmann/json.hpp>
+
+namespace leetcli {
+    struct PollOptions {
+        std::chrono::milliseconds first_delay{250};
+        std::chrono::milliseconds max_delay{3000};
+        double multiplier = 1.7;
+        double jitter = 0.2;                        // +/- fraction applied to every delay
+        std::chrono::milliseconds deadline{60000};  // total time we are willing to wait
+        int max_transient_errors = 3;               // consecutive 5xx/429/garbled replies tolerated
+        const std::atomic<bool>* cancel = nullptr;  // set from another thread to stop waiting early
+    };
+
+    enum class PollStatus { Success, Failure, Timeout, Error, Cancelled };
+
+    struct PollResult {
+        PollStatus status = PollStatus::Error;
+        nlohmann::json result;      // last /check/ payload
+        std::string error;
+        std::chrono::milliseconds waited{0};
+        int attempts = 0;
+    };
+
+    // Exponential backoff with jitter; also used by callers that poll several ids themselves
+    class Backoff {
+    public:
+        explicit Backoff(const PollOptions& options);
+        std::chrono::milliseconds next();
+
+    private:
+        PollOptions options_;
+        double current_ms_;
+        std::mt19937 rng_;
+    };
+
+    // One /check/ reply. Transient covers 5xx, 429, dropped connections and garbled bodies,
+    // which are retried; Error is anything else that isn't a 200.
+    enum class CheckState { Pending, Success, Failure, Transient, Error };
+
+    struct CheckReply {
+        CheckState state = CheckState::Error;
+        nlohmann::json body;
+        std::string error;
+    };
+
+    CheckReply read_check_reply(const cpr::Response& r);
+
+    // Poll a /submissions/detail/<id>/check/ style endpoint until it reaches SUCCESS or FAILURE
+    PollResult poll_until_done(const std::function<cpr::Response()>& check, const PollOptions& options = {});
+
+    std::string describe_wait(const PollResult& result);
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace leetcli {
+    struct PrefetchOptions {
+        bool daily = true;                 // include today's daily question
+        size_t next = 3;                   // how many not-yet-accepted study list entries to prepare
+        int jobs = 2;
+        std::int64_t rate_kb = 256;        // total download budget in KB/s, 0 = unlimited
+        bool low_priority = true;          // nice 19 (and idle I/O class on Linux)
+        bool quiet = false;
+        std::string lang_override;
+    };
+
+    // Fetches the daily question and the next entries of a study list ahead of time, so a later
+    // `fetch`/`solve` of them never touches the network. Meant for cron or a systemd timer.
+    // list_path may be empty (daily only). Returns the process exit code.
+    int prefetch(const std::string& list_path, const PrefetchOptions& options = {});
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <filesystem>
+#include <mutex>
+#include <streambuf>
+#include <string>
+
+namespace leetcli {
+    // What leetclid binds to each thread serving a client: where std::cout/std::cerr go and the
+    // client's working directory. The CLI never binds one, so output goes to the terminal as usual.
+    struct RequestContext {
+        std::streambuf* out = nullptr;
+        std::streambuf* err = nullptr;
+        mutable std::mutex output_mutex;  // a request's own worker threads share its streams
+        std::filesystem::path cwd;
+    };
+
+    // Makes std::cout and std::cerr write to the calling thread's request, if it has one.
+    // leetclid calls this once before serving; the stream objects themselves stay shared, so
+    // code that may run in a request formats into a string instead of setting stream flags.
+    void route_output_per_thread();
+
+    // nullptr outside a leetclid request
+    const RequestContext* current_request();
+
+    // Binds a request to the current thread for this object's lifetime; nullptr binds nothing
+    class RequestScope {
+    public:
+        explicit RequestScope(const RequestContext* request);
+        ~RequestScope();
+        RequestScope(const RequestScope&) = delete;
+        RequestScope& operator=(const RequestScope&) = delete;
+
+    private:
+        const RequestContext* previous_;
+    };
+
+    // The client's directory inside a leetclid request, the process's otherwise
+    std::filesystem::path working_directory();
+    // Relative paths from the command line are relative to working_directory()
+    std::filesystem::path resolve_path(const std::string& path);
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "leetcode_api.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    // Verdict of an earlier submission of the same code
+    struct CachedSubmission {
+        std::string status_msg;
+        std::string runtime;
+        std::string memory;
+        std::string submission_id;
+        int64_t submitted_at = 0; // unix seconds
+    };
+
+    // Keys hash the normalized code together with everything else the judge sees
+    std::string run_cache_key(const std::string& lang, const std::string& question_id, const std::string& code,
+                              const std::vector<std::string>& cases);
+    std::string submit_cache_key(const std::string& lang, const std::string& question_id, const std::string& code);
+
+    // Results live in ~/.leetcli/cache/results/<key>.json
+    std::optional<RunReport> lookup_run_result(const std::string& key);
+    void store_run_result(const std::string& key, const RunReport& report);
+    std::optional<CachedSubmission> lookup_submission(const std::string& key);
+    void store_submission(const std::string& key, const CachedSubmission& submission);
+}
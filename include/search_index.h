@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace leetcli {
+    struct SearchHit {
+        std::string folder;
+        double score = 0;
+    };
+
+    // Positional inverted index over the README.md files in the problems dir,
+    // kept in <problems_dir>/.leetcli/search.idx
+    class SearchIndex {
+    public:
+        bool load(const std::string& path);
+        bool save(const std::string& path) const;
+
+        // Re-indexes folders whose README.md is new or changed and drops folders that are gone
+        size_t refresh(const std::string& problems_dir, bool force_scan);
+        void index_folder(const std::string& folder_path);
+
+        // Plain words are ranked with BM25; "quoted phrases" must appear verbatim
+        std::vector<SearchHit> search(const std::string& query, size_t limit) const;
+
+        size_t document_count() const;
+
+    private:
+        struct Doc {
+            std::string folder;
+            int64_t mtime = 0;
+            uint32_t length = 0;
+            uint32_t title_length = 0; // first title_length positions come from the "# Title" line
+            bool live = false;
+        };
+        struct Posting {
+            uint32_t doc;
+            std::vector<uint32_t> positions;
+        };
+
+        void remove_doc(uint32_t id);
+        void add_doc(const std::string& folder, int64_t mtime, const std::string& text);
+        bool has_phrase(uint32_t doc, const std::vector<std::string>& phrase) const;
+        const Posting* find_posting(const std::string& term, uint32_t doc) const;
+
+        int64_t root_mtime_ = 0;
+        std::vector<Doc> docs_;
+        std::unordered_map<std::string, uint32_t> doc_by_folder_;
+        std::unordered_map<std::string, std::vector<Posting>> postings_;
+        uint64_t total_length_ = 0;
+    };
+
+    std::vector<std::string> tokenize(const std::string& text);
+
+    // Called after fetches so search never has to rescan for them
+    void update_search_index(const std::vector<std::string>& folder_paths);
+    void handle_search_command(const std::vector<std::string>& args);
+}
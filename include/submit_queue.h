@@ -0,0 +1,22 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace leetcli {
+    struct SubmitQueueOptions {
+        bool force = false;                             // resubmit code that was already Accepted
+        std::string lang_override;
+        std::chrono::milliseconds interval{2000};       // minimum gap between two submissions
+        std::chrono::milliseconds deadline{120000};     // per submission, from when it was posted
+    };
+
+    // Problems whose solution file was edited since its last submission (or, if never
+    // submitted, no longer matches the starter code)
+    std::vector<std::string> changed_solutions(const std::string& lang_override);
+
+    // Posts every submission, spaced out by options.interval and backing off on 429, while one
+    // loop polls all pending submission ids. Verdicts are printed as they land, then a table.
+    // Returns 0 when every problem ends up Accepted.
+    int submit_many(const std::vector<std::string>& slugs, const SubmitQueueOptions& options = {});
+}
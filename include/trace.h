@@ -0,0 +1,45 @@
+#pragma once
+#include <curl/curl.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace leetcli {
+    namespace detail {
+        extern std::atomic<bool> trace_on;
+    }
+
+    // --trace: one relaxed load, so spans cost next to nothing when tracing is off
+    inline bool trace_enabled() {
+        return detail::trace_on.load(std::memory_order_relaxed);
+    }
+
+    // Starts collecting. With a path, finish_trace() also writes Chrome trace_event JSON there
+    // (loads in Perfetto or chrome://tracing).
+    void enable_trace(const std::string& chrome_trace_path = "");
+
+    // Prints the summary table to stderr and writes the trace file, if any
+    void finish_trace();
+
+    // Times the enclosing scope. Names must be string literals; they are only copied when tracing.
+    class TraceSpan {
+    public:
+        explicit TraceSpan(const char* name, const char* category = "app")
+            : name_(name), category_(category), active_(trace_enabled()) {
+            if (active_) start_ = std::chrono::steady_clock::now();
+        }
+        ~TraceSpan();
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        const char* name_;
+        const char* category_;
+        bool active_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Records a finished curl transfer with its DNS / connect / TLS / server / download phases.
+    // The query string is dropped from the recorded URL (it may hold an API key).
+    void trace_http(const char* method, const std::string& url, CURL* handle, long status_code);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <chrono>
+#include <optional>
+#include <string>
+#include <cpr/cpr.h>
+
+namespace leetcli {
+    // What happens underneath every HTTP call: talk to the network (the default), talk to the
+    // network and save each exchange to a cassette, or answer from a cassette with no network.
+    enum class TransportMode { Passthrough, Record, Replay };
+
+    struct TransportOptions {
+        TransportMode mode = TransportMode::Passthrough;
+        std::string cassette_path; // JSON file of recorded exchanges
+        // Delay added to each replayed response; nullopt replays the recorded timing
+        std::optional<std::chrono::milliseconds> latency{std::chrono::milliseconds(0)};
+    };
+
+    void configure_transport(const TransportOptions& options);
+    TransportMode transport_mode();
+
+    // Replay mode: the recorded response for this request, or a status-0 error response when the
+    // cassette has none. Other modes: nullopt, so the caller goes to the network.
+    // Repeated identical requests (polling) get their recorded responses in order, then the last one.
+    std::optional<cpr::Response> replay_exchange(const std::string& method, const std::string& url, const std::string& body);
+
+    // Record mode: appends the exchange to the cassette (written right away). No-op otherwise.
+    void record_exchange(const std::string& method, const std::string& url, const std::string& body,
+                         const cpr::Response& response);
+}
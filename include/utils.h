@@ -4,11 +4,15 @@
 #include <filesystem>
 #include <optional>
 #include <vector>
+#include <nlohmann/json.hpp>
 
 namespace leetcli {
     void set_gemini_key(const std::string& key);
     std::string get_gemini_key();
-    static std::filesystem::path get_home();
+    std::filesystem::path get_home();
+    bool write_file_atomic(const std::filesystem::path& path, const std::string& contents);
+    // 64-bit FNV-1a as 16 hex digits; for cache keys, not security
+    std::string hash_hex(const std::string& data);
     std::string get_file_extension(const std::string& filename);
     void init_problems_folder();
     std::string html_to_text(const std::string& html);
@@ -16,14 +20,31 @@ namespace leetcli {
     void write_solution_file(const std::string& path, const std::string& code);
     void launch_in_editor(const std::string& path);
     std::string get_problems_dir();
+    // <problems_dir>/.leetcli: writes in here don't touch the problems dir mtime
+    std::filesystem::path get_workspace_state_dir();
     std::string get_preferred_language();
     void set_session_cookie();
     std::string get_session_cookie();
     std::string get_csrf_token();
     int get_solution_folder(const std::string &slug, std::string &folder_path);
-    std::string get_question_id(const std::string& slug, const std::string& session, const std::string& csrf);
-    void fetch_testcases(const std::string& slug, const std::string& folder_path);
+    std::string get_question_id(const std::string& slug);
+    void save_testcases(const std::string& folder_path, const std::vector<std::string>& testcases);
+    void write_problem_json(const std::string& folder_path, const nlohmann::json& question);
+    std::optional<nlohmann::json> load_local_problem(const std::string& slug);
     std::vector<std::string> load_testcases(const std::string& filepath);
+    // One row per language leetcli keeps solution files for
+    struct Language {
+        std::string name;       // --lang value and LeetCode's snippet langSlug
+        std::string extension;  // ".cpp"
+        std::string judge_lang; // what run/submit send to LeetCode
+    };
+
+    // Where two names share an extension (python/python3), the first one listed owns it
+    const std::vector<Language>& supported_languages();
+    const Language* find_language(const std::string& name);
+    const Language* language_for_extension(const std::string& extension);
+    // ".cpp" for "cpp" etc.; nullopt for languages leetcli has no solution file for
+    std::optional<std::string> solution_extension(const std::string& lang);
     int get_solution_filepath(const std::string& slug, std::string& solution_file,  const std::optional<std::string> &language = std::nullopt);
     void handle_config_command(const std::vector<std::string> &args);
 }
@@ -0,0 +1,15 @@
+#pragma once
+#include "leetcode_api.h"
+#include <chrono>
+#include <string>
+
+namespace leetcli {
+    struct WatchOptions {
+        RunOptions run;                             // --local / --remote, passed to every run
+        std::chrono::milliseconds debounce{200};    // quiet time after the last save before running
+    };
+
+    // Re-runs the testcases every time the solution file is saved, in one long-lived process so
+    // metadata and HTTP connections stay warm. A save during a run cancels it. Blocks until Ctrl-C.
+    int watch_solution(const std::string& slug, const std::string& lang_override, const WatchOptions& options = {});
+}
@@ -0,0 +1,255 @@
+#include "bulk_fetch.h"
+#include "leetcode_api.h"
+#include "leetcode_client.h"
+#include "manifest.h"
+#include "metadata_cache.h"
+#include "request_context.h"
+#include "search_index.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace leetcli {
+
+    namespace {
+        std::string trim(const std::string& s) {
+            size_t b = s.find_first_not_of(" \t\r\n");
+            if (b == std::string::npos) return "";
+            size_t e = s.find_last_not_of(" \t\r\n");
+            return s.substr(b, e - b + 1);
+        }
+    }
+
+    std::vector<std::string> read_slug_list(std::istream& in) {
+        std::vector<std::string> slugs;
+        std::set<std::string> seen;
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t hash = line.find('#');
+            if (hash != std::string::npos) line.erase(hash);
+            line = trim(line);
+            if (line.empty()) continue;
+
+            // https://leetcode.com/problems/two-sum/description/ -> two-sum
+            const std::string marker = "/problems/";
+            if (size_t pos = line.find(marker); pos != std::string::npos) {
+                line = line.substr(pos + marker.size());
+                line = line.substr(0, line.find('/'));
+            }
+            if (!line.empty() && seen.insert(line).second) slugs.push_back(line);
+        }
+        return slugs;
+    }
+
+    std::vector<std::string> fetch_tag_slugs(const std::string& tag, bool include_paid, std::string& error) {
+        std::vector<std::string> slugs;
+        const int page_size = 100;
+        int total = -1;
+
+        for (int skip = 0; total < 0 || skip < total; skip += page_size) {
+            nlohmann::json query = {
+                {
+                    "query", R"(
+                query problemsetQuestionList($categorySlug: String, $limit: Int, $skip: Int, $filters: QuestionListFilterInput) {
+                    problemsetQuestionList: questionList(categorySlug: $categorySlug, limit: $limit, skip: $skip, filters: $filters) {
+                        total: totalNum
+                        questions: data {
+                            titleSlug
+                            paidOnly: isPaidOnly
+                        }
+                    }
+                }
+            )"
+                },
+                {"variables", {
+                    {"categorySlug", ""},
+                    {"limit", page_size},
+                    {"skip", skip},
+                    {"filters", {{"tags", {tag}}}}
+                }}
+            };
+
+            cpr::Response r = client().graphql(query, Auth::None, "https://leetcode.com/problemset/all/");
+            if (r.status_code != 200) {
+                error = "Failed to list problems for tag \"" + tag + "\": HTTP " + std::to_string(r.status_code);
+                break;
+            }
+
+            auto json = nlohmann::json::parse(r.text, nullptr, false);
+            if (json.is_discarded() || !json.contains("data") || json["data"].is_null() ||
+                json["data"]["problemsetQuestionList"].is_null()) {
+                error = "Invalid response when listing tag \"" + tag + "\"";
+                break;
+            }
+
+            const auto& list = json["data"]["problemsetQuestionList"];
+            total = list.value("total", 0);
+            const auto& questions = list["questions"];
+            if (!questions.is_array() || questions.empty()) break;
+            for (const auto& q : questions) {
+                if (!include_paid && q.value("paidOnly", false)) continue;
+                slugs.push_back(q["titleSlug"].get<std::string>());
+            }
+        }
+        return slugs;
+    }
+
+    bool is_problem_materialized(const std::string& slug) {
+        auto meta = lookup_question_meta(slug);
+        if (!meta) return false;
+        return std::filesystem::exists(std::filesystem::path(get_problems_dir()) / meta->folder / "problem.json");
+    }
+
+    BulkFetchSummary fetch_many(const std::vector<std::string>& slugs, const BulkFetchOptions& options) {
+        BulkFetchSummary summary;
+        MetadataWriteBatch batch;   // one metadata.json write for the whole run
+        get_problems_dir();         // load config before the workers start
+
+        std::mutex out_mutex;
+        std::vector<std::string> fetched_folders;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        const auto start = std::chrono::steady_clock::now();
+
+        auto worker = [&] {
+            while (true) {
+                size_t i = next++;
+                if (i >= slugs.size()) return;
+                const std::string& slug = slugs[i];
+
+                std::string status;
+                bool ok = true;
+                bool skipped = !options.force && is_problem_materialized(slug);
+                if (!skipped) {
+                    FetchResult result = fetch_problem_files(slug, options.lang_override);
+                    ok = result.ok;
+                    status = ok ? result.title : result.error;
+                    if (ok) {
+                        std::lock_guard<std::mutex> lock(out_mutex);
+                        fetched_folders.push_back(result.folder_path);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(out_mutex);
+                size_t n = ++done;
+                if (skipped) {
+                    ++summary.skipped;
+                } else if (ok) {
+                    ++summary.fetched;
+                } else {
+                    summary.failures.emplace_back(slug, status);
+                }
+                if (!options.quiet) {
+                    std::cout << "[" << n << "/" << slugs.size() << "] "
+                              << (skipped ? "⏭️  " : ok ? "✅ " : "❌ ") << slug
+                              << (skipped ? " (already fetched)" : " — " + status) << "\n";
+                }
+            }
+        };
+
+        size_t jobs = std::clamp<size_t>(static_cast<size_t>(std::max(options.jobs, 1)), 1, std::max<size_t>(slugs.size(), 1));
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < jobs; ++t) {
+            // Workers print to the same client and resolve paths against its directory
+            threads.emplace_back([&worker, request = current_request()] {
+                RequestScope scope(request);
+                worker();
+            });
+        }
+        for (auto& t : threads) t.join();
+        update_search_index(fetched_folders);
+        update_manifest(fetched_folders);
+
+        summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return summary;
+    }
+
+    void print_bulk_summary(const BulkFetchSummary& summary) {
+        double rate = summary.seconds > 0 ? summary.fetched / summary.seconds : 0;
+        std::ostringstream out;
+        out << "\nFetched " << summary.fetched << ", skipped " << summary.skipped
+            << ", failed " << summary.failures.size() << " in " << std::fixed << std::setprecision(2)
+            << summary.seconds << " s (" << rate << " problems/sec)\n";
+        std::cout << out.str();
+        if (!summary.failures.empty()) {
+            std::cout << "Failures:\n";
+            for (const auto& [slug, reason] : summary.failures) {
+                std::cout << "  " << slug << ": " << reason << "\n";
+            }
+        }
+    }
+
+    int handle_fetch_many_command(const std::vector<std::string>& args) {
+        BulkFetchOptions options;
+        std::vector<std::string> slugs;
+        std::string list_path;
+        std::string tag;
+        bool tag_failed = false;
+
+        for (size_t i = 1; i < args.size(); ++i) {
+            const std::string& arg = args[i];
+            if (arg.rfind("--jobs=", 0) == 0) {
+                options.jobs = std::max(1, std::atoi(arg.substr(7).c_str()));
+            } else if (arg.rfind("--tag=", 0) == 0) {
+                tag = arg.substr(6);
+            } else if (arg.rfind("--lang=", 0) == 0) {
+                options.lang_override = arg.substr(7);
+            } else if (arg == "--force") {
+                options.force = true;
+            } else if (arg == "--include-paid") {
+                options.include_paid = true;
+            } else if (arg == "--quiet") {
+                options.quiet = true;
+            } else if (list_path.empty()) {
+                list_path = arg;
+            }
+        }
+
+        if (list_path.empty() && tag.empty()) {
+            std::cerr << "Usage: leetcli fetch-many <file|-> [--tag=<topic>] [--jobs=N] [--force] [--lang=...]\n";
+            return 1;
+        }
+
+        if (list_path == "-") {
+            slugs = read_slug_list(std::cin);
+        } else if (!list_path.empty()) {
+            std::ifstream in(resolve_path(list_path));
+            if (!in) {
+                std::cerr << "Could not open " << list_path << "\n";
+                return 1;
+            }
+            slugs = read_slug_list(in);
+        }
+        if (!tag.empty()) {
+            std::string error;
+            auto tagged = fetch_tag_slugs(tag, options.include_paid, error);
+            if (!error.empty()) {
+                // Whatever was listed before the failure is still fetched, but the run counts as failed
+                std::cerr << "❌ " << error << "\n";
+                tag_failed = true;
+            }
+            for (auto& slug : tagged) {
+                if (std::find(slugs.begin(), slugs.end(), slug) == slugs.end()) slugs.push_back(slug);
+            }
+        }
+
+        if (slugs.empty()) {
+            std::cerr << "No problems to fetch.\n";
+            return 1;
+        }
+
+        std::cout << "Fetching " << slugs.size() << " problems with " << options.jobs << " workers...\n";
+        BulkFetchSummary summary = fetch_many(slugs, options);
+        print_bulk_summary(summary);
+        return summary.failures.empty() && !tag_failed ? 0 : 1;
+    }
+}
@@ -0,0 +1,290 @@
+#include "catalog.h"
+#include "leetcode_client.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace leetcli {
+
+    namespace {
+        constexpr int kPageSize = 100;
+        const char* kCatalogHeader = "#leetcli-catalog v1";
+        const char* kFullSyncPrefix = "#full-sync ";
+        // Acceptance rates, tags and paid flags of older problems only change on a full pass
+        constexpr std::chrono::hours kFullSyncInterval{24 * 7};
+
+        std::filesystem::path catalog_path() {
+            return get_home() / ".leetcli/catalog.tsv";
+        }
+
+        std::string lower(std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+            return s;
+        }
+
+        // "Dynamic Programming" and "dynamic-programming" both name the same tag
+        std::string tag_key(const std::string& tag) {
+            std::string key = lower(tag);
+            std::replace(key.begin(), key.end(), ' ', '-');
+            return key;
+        }
+
+        std::string strip_tabs(std::string s) {
+            std::replace(s.begin(), s.end(), '\t', ' ');
+            std::replace(s.begin(), s.end(), '\n', ' ');
+            return s;
+        }
+
+        int64_t unix_now() {
+            return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        // full_sync_at: Unix seconds of the last sync that refreshed every page, 0 if never
+        bool save_catalog(const std::vector<CatalogEntry>& catalog, int64_t full_sync_at) {
+            std::ostringstream out;
+            out << kCatalogHeader << "\n";
+            if (full_sync_at) out << kFullSyncPrefix << full_sync_at << "\n";
+            out << std::fixed << std::setprecision(1);
+            for (const auto& e : catalog) {
+                out << e.frontend_id << '\t' << e.slug << '\t' << strip_tabs(e.title) << '\t' << e.difficulty << '\t'
+                    << e.acceptance << '\t' << (e.paid_only ? 1 : 0) << '\t';
+                for (size_t i = 0; i < e.tags.size(); ++i) out << (i ? "," : "") << e.tags[i];
+                out << '\n';
+            }
+            return write_file_atomic(catalog_path(), out.str());
+        }
+
+        // Returns the problem count reported by LeetCode, or -1 on failure
+        int fetch_catalog_page(int skip, std::vector<CatalogEntry>& into) {
+            nlohmann::json query = {
+                {
+                    "query", R"(
+                query problemsetQuestionList($categorySlug: String, $limit: Int, $skip: Int, $filters: QuestionListFilterInput) {
+                    problemsetQuestionList: questionList(categorySlug: $categorySlug, limit: $limit, skip: $skip, filters: $filters) {
+                        total: totalNum
+                        questions: data {
+                            frontendQuestionId: questionFrontendId
+                            titleSlug
+                            title
+                            difficulty
+                            acRate
+                            paidOnly: isPaidOnly
+                            topicTags {
+                                slug
+                            }
+                        }
+                    }
+                }
+            )"
+                },
+                {"variables", {{"categorySlug", ""}, {"limit", kPageSize}, {"skip", skip}, {"filters", nlohmann::json::object()}}}
+            };
+
+            cpr::Response r = client().graphql(query, Auth::None, "https://leetcode.com/problemset/all/");
+            if (r.status_code != 200) {
+                std::cerr << "Failed to fetch catalog page at " << skip << ": HTTP " << r.status_code << "\n";
+                return -1;
+            }
+
+            auto json = nlohmann::json::parse(r.text, nullptr, false);
+            if (json.is_discarded() || !json.contains("data") || json["data"].is_null() ||
+                json["data"]["problemsetQuestionList"].is_null()) {
+                std::cerr << "Invalid response for catalog page at " << skip << ".\n";
+                return -1;
+            }
+
+            const auto& list = json["data"]["problemsetQuestionList"];
+            for (const auto& q : list.value("questions", nlohmann::json::array())) {
+                CatalogEntry e;
+                e.frontend_id = q.value("frontendQuestionId", "");
+                e.slug = q.value("titleSlug", "");
+                e.title = q.value("title", "");
+                e.difficulty = q.value("difficulty", "");
+                e.acceptance = q.value("acRate", 0.0);
+                e.paid_only = q.value("paidOnly", false);
+                for (const auto& tag : q.value("topicTags", nlohmann::json::array())) {
+                    e.tags.push_back(tag.value("slug", ""));
+                }
+                if (!e.slug.empty()) into.push_back(std::move(e));
+            }
+            return list.value("total", 0);
+        }
+
+        bool matches(const CatalogEntry& e, const CatalogFilter& f) {
+            if (!f.difficulty.empty() && lower(e.difficulty) != lower(f.difficulty)) return false;
+            if (f.min_acceptance && e.acceptance < *f.min_acceptance) return false;
+            if (f.max_acceptance && e.acceptance > *f.max_acceptance) return false;
+            if (f.paid_only && e.paid_only != *f.paid_only) return false;
+            for (const auto& tag : f.tags) {
+                std::string key = tag_key(tag);
+                if (std::find(e.tags.begin(), e.tags.end(), key) == e.tags.end()) return false;
+            }
+            if (!f.title_contains.empty() && lower(e.title).find(lower(f.title_contains)) == std::string::npos) return false;
+            return true;
+        }
+
+        std::vector<CatalogEntry> read_catalog(int64_t& full_sync_at) {
+            std::vector<CatalogEntry> catalog;
+            full_sync_at = 0;
+            std::ifstream in(catalog_path());
+            if (!in) return catalog;
+
+            std::string line;
+            if (!std::getline(in, line) || line != kCatalogHeader) return catalog;
+
+            catalog.reserve(4096);
+            while (std::getline(in, line)) {
+                if (line.rfind(kFullSyncPrefix, 0) == 0) {
+                    full_sync_at = std::strtoll(line.c_str() + std::strlen(kFullSyncPrefix), nullptr, 10);
+                    continue;
+                }
+                std::string_view rest(line);
+                std::string_view fields[7];
+                size_t n = 0;
+                while (n < 7) {
+                    size_t tab = rest.find('\t');
+                    fields[n++] = rest.substr(0, tab);
+                    if (tab == std::string_view::npos) break;
+                    rest.remove_prefix(tab + 1);
+                }
+                if (n < 6) continue;
+
+                CatalogEntry e;
+                e.frontend_id = std::string(fields[0]);
+                e.slug = std::string(fields[1]);
+                e.title = std::string(fields[2]);
+                e.difficulty = std::string(fields[3]);
+                e.acceptance = std::strtod(std::string(fields[4]).c_str(), nullptr);
+                e.paid_only = fields[5] == "1";
+                if (n == 7) {
+                    std::string_view tags = fields[6];
+                    while (!tags.empty()) {
+                        size_t comma = tags.find(',');
+                        e.tags.emplace_back(tags.substr(0, comma));
+                        if (comma == std::string_view::npos) break;
+                        tags.remove_prefix(comma + 1);
+                    }
+                }
+                catalog.push_back(std::move(e));
+            }
+            return catalog;
+        }
+    }
+
+    std::vector<CatalogEntry> load_catalog() {
+        int64_t full_sync_at;
+        return read_catalog(full_sync_at);
+    }
+
+    bool sync_catalog(bool full) {
+        auto start = std::chrono::steady_clock::now();
+        int64_t full_sync_at = 0;
+        std::vector<CatalogEntry> catalog = full ? std::vector<CatalogEntry>{} : read_catalog(full_sync_at);
+
+        // Earlier pages keep their problems but not their stats, so refresh all of them once the
+        // last full pass is too old (or predates this field)
+        auto age = std::chrono::seconds(unix_now() - full_sync_at);
+        if (!full && !catalog.empty() && age > kFullSyncInterval) {
+            std::cout << "Catalog stats are over " << kFullSyncInterval.count() / 24 << " days old; refreshing every page.\n";
+            catalog.clear();
+        }
+        full = full || catalog.empty();
+
+        // The list is ordered by problem number and new problems are appended, so only the
+        // last (possibly partial) page and anything after it can have changed membership.
+        size_t keep = (catalog.size() / kPageSize) * kPageSize;
+        catalog.resize(keep);
+
+        std::vector<CatalogEntry> fetched;
+        int total = -1;
+        int pages = 0;
+        for (int skip = static_cast<int>(keep); total < 0 || skip < total; skip += kPageSize) {
+            size_t before = fetched.size();
+            total = fetch_catalog_page(skip, fetched);
+            if (total < 0) return false;
+            ++pages;
+            if (fetched.size() == before) break;
+            std::cout << "\rSynced " << (keep + fetched.size()) << " / " << total << " problems" << std::flush;
+        }
+        std::cout << "\n";
+
+        catalog.insert(catalog.end(), std::make_move_iterator(fetched.begin()), std::make_move_iterator(fetched.end()));
+        if (!save_catalog(catalog, full ? unix_now() : full_sync_at)) {
+            std::cerr << "Failed to write " << catalog_path() << "\n";
+            return false;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::ostringstream out;
+        out << "✅ Catalog has " << catalog.size() << " problems (" << pages << (pages == 1 ? " page" : " pages")
+            << " fetched in " << std::fixed << std::setprecision(2) << seconds << " s)\n";
+        std::cout << out.str();
+        return true;
+    }
+
+    std::vector<CatalogEntry> query_catalog(const std::vector<CatalogEntry>& catalog, const CatalogFilter& filter) {
+        std::vector<CatalogEntry> out;
+        for (const auto& e : catalog) {
+            if (!matches(e, filter)) continue;
+            out.push_back(e);
+            if (filter.limit && out.size() >= filter.limit) break;
+        }
+        return out;
+    }
+
+    void handle_catalog_command(const std::vector<std::string>& args) {
+        if (args.size() >= 2 && args[1] == "sync") {
+            bool full = std::find(args.begin(), args.end(), "--full") != args.end();
+            sync_catalog(full);
+        } else {
+            std::cerr << "Usage: leetcli catalog sync [--full]\n";
+        }
+    }
+
+    void handle_problems_command(const std::vector<std::string>& args) {
+        CatalogFilter filter;
+        for (size_t i = 1; i < args.size(); ++i) {
+            const std::string& arg = args[i];
+            auto value = [&](const char* prefix) { return arg.substr(std::string(prefix).size()); };
+            if (arg.rfind("--difficulty=", 0) == 0) filter.difficulty = value("--difficulty=");
+            else if (arg.rfind("--tag=", 0) == 0) filter.tags.push_back(value("--tag="));
+            else if (arg.rfind("--min-acceptance=", 0) == 0) filter.min_acceptance = std::atof(value("--min-acceptance=").c_str());
+            else if (arg.rfind("--max-acceptance=", 0) == 0) filter.max_acceptance = std::atof(value("--max-acceptance=").c_str());
+            else if (arg.rfind("--search=", 0) == 0) filter.title_contains = value("--search=");
+            else if (arg.rfind("--limit=", 0) == 0) filter.limit = static_cast<size_t>(std::max(0, std::atoi(value("--limit=").c_str())));
+            else if (arg == "--free") filter.paid_only = false;
+            else if (arg == "--paid") filter.paid_only = true;
+            else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                std::cerr << "Usage: leetcli problems [--difficulty=Easy|Medium|Hard] [--tag=<topic>]... "
+                             "[--min-acceptance=N] [--max-acceptance=N] [--free|--paid] [--search=text] [--limit=N]\n";
+                return;
+            }
+        }
+
+        auto catalog = load_catalog();
+        if (catalog.empty()) {
+            std::cerr << "No local catalog. Run `leetcli catalog sync` first.\n";
+            return;
+        }
+
+        auto results = query_catalog(catalog, filter);
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1);
+        for (const auto& e : results) {
+            out << std::setw(5) << e.frontend_id << "  " << std::left << std::setw(7) << e.difficulty << std::right
+                << std::setw(6) << e.acceptance << "%  " << (e.paid_only ? "🔒 " : "") << e.title << "  (" << e.slug << ")\n";
+        }
+        out << results.size() << (results.size() == 1 ? " problem" : " problems") << " matched";
+        if (filter.limit && results.size() >= filter.limit) out << " (limit " << filter.limit << ", use --limit=0 for all)";
+        out << "\n";
+        std::cout << out.str();
+    }
+}
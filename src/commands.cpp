@@ -0,0 +1,395 @@
+#include "commands.h"
+#include "daemon.h"
+#include "leetcode_api.h"
+#include "utils.h"
+#include "metadata_cache.h"
+#include "bulk_fetch.h"
+#include "catalog.h"
+#include "search_index.h"
+#include "manifest.h"
+#include "watch.h"
+#include "prefetch.h"
+#include "submit_queue.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+
+namespace leetcli {
+    int run_command(const std::vector<std::string>& args) {
+        if (args.empty()) {
+            std::cout << "Usage:\n"
+                    << "  leetcli init\n"
+                    << "  leetcli fetch <slug>\n";
+            return 1;
+        }
+
+        std::string command = args[0];
+
+        if (command == "daemon") {
+            return leetcli::handle_daemon_command(args);
+        }
+
+        if (command == "init") {
+            leetcli::init_problems_folder();
+            return 0;
+        }
+
+        if (command == "fetch") {
+
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli fetch <slug> [--lang=cpp|python|java|all] [--force]\n";
+                return 1;
+            }
+
+            std::string slug = args[1];
+
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+
+            std::string lang_override;
+            bool force = false;
+
+            // Check for --lang=xxx
+            for (size_t i = 2; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--lang=", 0) == 0) {
+                    lang_override = arg.substr(7); // everything after --lang=
+                } else if (arg == "--force") {
+                    force = true;
+                }
+            }
+
+            std::string problem = leetcli::fetch_problem(slug, lang_override, force); // pass override to function
+            std::cout << problem << "\n";
+            return 0;
+        }
+
+        if (command == "fetch-many" || command == "sync") {
+            return leetcli::handle_fetch_many_command(args);
+        }
+
+        if (command == "prefetch") {
+            leetcli::PrefetchOptions options;
+            std::string list_path;
+
+            for (size_t i = 1; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--next=", 0) == 0) {
+                    options.next = static_cast<size_t>(std::max(0, std::atoi(arg.substr(7).c_str())));
+                } else if (arg.rfind("--jobs=", 0) == 0) {
+                    options.jobs = std::max(1, std::atoi(arg.substr(7).c_str()));
+                } else if (arg.rfind("--rate=", 0) == 0) {
+                    options.rate_kb = std::max(0, std::atoi(arg.substr(7).c_str()));
+                } else if (arg.rfind("--lang=", 0) == 0) {
+                    options.lang_override = arg.substr(7);
+                } else if (arg == "--no-daily") {
+                    options.daily = false;
+                } else if (arg == "--no-nice") {
+                    options.low_priority = false;
+                } else if (arg == "--quiet") {
+                    options.quiet = true;
+                } else if (list_path.empty()) {
+                    list_path = arg;
+                }
+            }
+            if (list_path.empty() && !options.daily) {
+                std::cerr << "Usage: leetcli prefetch [study-list] [--next=N] [--no-daily] [--rate=KB/s] [--jobs=N]\n";
+                return 1;
+            }
+            return leetcli::prefetch(list_path, options);
+        }
+
+        if (command == "solve") {
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli solve <slug> [--lang=cpp|python|java]\n";
+                return 1;
+            }
+            std::string lang_override;
+
+            for (size_t i = 2; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--lang=", 0) == 0) {
+                    lang_override = arg.substr(7);
+                }
+            }
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            leetcli::solve_problem(slug, lang_override);
+            return 0;
+        }
+        if (command == "hints") {
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli hints <slug>\n";
+                return 1;
+            }
+
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            leetcli::fetch_problem_hints(slug);
+            return 0;
+        }
+        if (command == "topics") {
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli topics <slug>\n";
+                return 1;
+            }
+
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            leetcli::fetch_problem_topics(slug);
+            return 0;
+        }
+        if (command == "catalog") {
+            leetcli::handle_catalog_command(args);
+            return 0;
+        }
+        if (command == "search") {
+            leetcli::handle_search_command(args);
+            return 0;
+        }
+
+        if (command == "problems") {
+            leetcli::handle_problems_command(args);
+            return 0;
+        }
+        if (command == "list") {
+            leetcli::handle_list_command(args);
+            return 0;
+        }
+
+        if (command == "login") {
+            leetcli::set_session_cookie();
+            return 0;
+        }
+        if (command == "submit") {
+            bool batch = std::find(args.begin(), args.end(), "--batch") != args.end();
+            bool all_changed = std::find(args.begin(), args.end(), "--all-changed") != args.end();
+            if (batch || all_changed) {
+                leetcli::SubmitQueueOptions options;
+                std::vector<std::string> slugs;
+                for (size_t i = 1; i < args.size(); ++i) {
+                    std::string arg = args[i];
+                    if (arg.rfind("--lang=", 0) == 0) {
+                        options.lang_override = arg.substr(7);
+                    } else if (arg == "--force") {
+                        options.force = true;
+                    } else if (arg.rfind("--interval=", 0) == 0) {
+                        options.interval = std::chrono::milliseconds(std::max(0, std::atoi(arg.substr(11).c_str())));
+                    } else if (arg.rfind("--", 0) != 0) {
+                        slugs.push_back(arg == "daily" ? leetcli::get_daily_question_slug() : arg);
+                    }
+                }
+                if (all_changed) {
+                    for (auto& slug : leetcli::changed_solutions(options.lang_override)) {
+                        if (std::find(slugs.begin(), slugs.end(), slug) == slugs.end()) slugs.push_back(slug);
+                    }
+                }
+                if (slugs.empty()) {
+                    std::cerr << (all_changed ? "No changed solutions to submit.\n"
+                                              : "Usage: leetcli submit --batch <slug>... [--all-changed] [--interval=MS]\n");
+                    return all_changed ? 0 : 1;
+                }
+                std::cout << "Submitting " << slugs.size() << (slugs.size() == 1 ? " problem" : " problems") << "...\n";
+                return leetcli::submit_many(slugs, options);
+            }
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli submit <slug> [--lang=cpp|python|java] [--force]\n";
+                return 1;
+            }
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            std::string lang_override;
+            bool force = false;
+
+            for (size_t i = 2; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--lang=", 0) == 0) {
+                    lang_override = arg.substr(7);
+                } else if (arg == "--force") {
+                    force = true;
+                }
+            }
+
+            leetcli::submit_solution(slug, lang_override, force);
+            return 0;
+        }
+        if (command == "run") {
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli run <slug> [--lang=cpp|python|java|all] [--local|--remote]\n";
+                return 1;
+            }
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            std::string lang_override;
+            leetcli::RunOptions options;
+
+            for (size_t i = 2; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--lang=", 0) == 0) {
+                    lang_override = arg.substr(7);
+                } else if (arg == "--local") {
+                    options.local = true;
+                } else if (arg == "--remote") {
+                    options.remote = true;
+                }
+            }
+            if (lang_override == "all") {
+                leetcli::run_language_matrix(slug, options);
+            } else {
+                leetcli::run_tests(slug, lang_override, options);
+            }
+            return 0;
+        }
+        if (command == "watch") {
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli watch <slug> [--lang=cpp|python|java] [--local|--remote] [--debounce=MS]\n";
+                return 1;
+            }
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            std::string lang_override;
+            leetcli::WatchOptions options;
+
+            for (size_t i = 2; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--lang=", 0) == 0) {
+                    lang_override = arg.substr(7);
+                } else if (arg == "--local") {
+                    options.run.local = true;
+                } else if (arg == "--remote") {
+                    options.run.remote = true;
+                } else if (arg.rfind("--debounce=", 0) == 0) {
+                    options.debounce = std::chrono::milliseconds(std::max(0, std::atoi(arg.substr(11).c_str())));
+                }
+            }
+            return leetcli::watch_solution(slug, lang_override, options);
+        } if (command == "config") {
+            leetcli::handle_config_command(args);
+            return 0;
+        }
+        if (command == "cache") {
+            leetcli::handle_cache_command(args);
+            return 0;
+        }
+        if (command == "runtime") {
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli runtime <slug> [--lang=cpp|python|java] [--no-cache]\n";
+                return 1;
+            }
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            std::string lang_override;
+            leetcli::GeminiOptions options;
+
+            for (size_t i = 2; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--lang=", 0) == 0) {
+                    lang_override = arg.substr(7);
+                } else if (arg == "--no-cache") {
+                    options.use_cache = false;
+                }
+            }
+            leetcli::analyze_runtime(slug, lang_override, options);
+            return 0;
+        }
+        if (command == "hint") {
+            if (args.size() < 2) {
+                std::cerr << "Usage: leetcli hint <slug> [--lang=cpp|python|java] [--no-cache] [--verbose]\n";
+                return 1;
+            }
+            std::string slug = args[1];
+            if (slug == "daily") {
+                slug = leetcli::get_daily_question_slug();
+            }
+            std::string lang_override;
+            leetcli::GeminiOptions options;
+
+            for (size_t i = 2; i < args.size(); ++i) {
+                std::string arg = args[i];
+                if (arg.rfind("--lang=", 0) == 0) {
+                    lang_override = arg.substr(7);
+                } else if (arg == "--no-cache") {
+                    options.use_cache = false;
+                } else if (arg == "--verbose") {
+                    options.verbose = true;
+                }
+            }
+            leetcli::give_hint(slug, lang_override, options);
+            return 0;
+        }
+        if (command == "help") {
+            std::cout << "leetcli - LeetCode CLI Tool\n\n"
+                      << "Usage:\n"
+                      << "  leetcli init                        Initialize the problems directory in your current directory\n"
+                      << "  leetcli fetch <slug> [--lang=...]   Fetch a problem by slug or use 'daily' for the daily question\n"
+                      << "                       [--force]          ...again, even if it is already on disk\n"
+                      << "  leetcli fetch-many <file|-> [--tag=<topic>] [--jobs=N] [--force]\n"
+                      << "                                      Fetch many problems in parallel (alias: sync)\n"
+                      << "  leetcli prefetch [list] [--next=N]  Quietly fetch the daily question and the next N unsolved problems\n"
+                      << "                   [--rate=KB/s]          of a study list ahead of time (for cron / systemd timers)\n"
+                      << "  leetcli solve <slug> [--lang=...]   Open the solution file in your default editor\n"
+                      << "  leetcli list [--sort=...] [--status=solved|attempted|todo] [--lang=...] [--difficulty=...]\n"
+                      << "                                      List fetched problems with their last run/submit result\n"
+                      << "  leetcli catalog sync [--full]       Mirror the full LeetCode problem list locally\n"
+                      << "  leetcli problems [filters...]       Query the local catalog (--difficulty, --tag, --max-acceptance, ...)\n"
+                      << "  leetcli search words [--limit=N]    Full-text search over fetched problem statements\n"
+                      << "  leetcli login                       Set your LEETCODE_SESSION and CSRF token\n"
+                      << "  leetcli run <slug>  [--lang=...]    Run your solution against LeetCode testcases\n"
+                      << "                      [--local]         ...or compile and run a C++ solution on this machine\n"
+                      << "                      [--lang=all]      ...every solution.* at once, as one result matrix\n"
+                      << "  leetcli watch <slug> [--lang=...]   Re-run the testcases every time you save the solution\n"
+                      << "  leetcli submit <slug> [--lang=...]  Submit your solution to LeetCode\n"
+                      << "                        [--force]         ...even if this exact code was already Accepted\n"
+                      << "  leetcli submit --batch <slug>...    Submit several problems and wait for all verdicts at once\n"
+                      << "  leetcli submit --all-changed        ...every solution edited since it was last submitted\n"
+                      << "  leetcli runtime <slug> [--lang=...] Analyze time/space complexity using Gemini\n"
+                      << "  leetcli hint <slug> [--lang=...]    Ask Gemini for a helpful hint based on your solution progress\n"
+                      << "                                      (runtime/hint answers are cached; --no-cache asks again)\n"
+                      << "                                      (hint streams as it's written; --verbose shows timings)\n"
+                      << "  leetcli hints <slug>                Gets the hints for the given problem in leetcode\n"
+                      << "  leetcli topics <slug>               Gets the topics for the given problem in leetcode\n"
+                      << "  leetcli config set-gemini-key <key> Set your Gemini API key\n"
+                      << "  leetcli cache clear [slug]          Forget cached problem metadata (all or one slug)\n"
+                      << "  leetcli daemon start|stop|status    Keep a warm background leetclid that runs commands for you\n"
+                      << "  leetcli help                        Show this help message\n"
+                      << "\n"
+                      << "  --trace[=trace.json]                Any command: print where the time went (HTTP phases, judge wait,\n"
+                      << "                                      file I/O, JSON parsing) and optionally write a Chrome trace\n"
+                      << "  --record[=cassette.json]            Any command: save every HTTP exchange to a cassette\n"
+                      << "  --replay[=cassette.json]            Any command: answer HTTP requests from a cassette, offline\n"
+                      << "  --replay-latency=MS|recorded        Delay each replayed response (default 0)\n"
+                      << "  --passthrough                       Use the network directly (the default)\n";
+            return 0;
+        }
+
+        std::cerr << "Unknown command: " << command << "\n";
+        return 1;
+    }
+
+    bool runs_in_daemon(const std::vector<std::string>& args) {
+        // init/login/config prompt on stdin, solve opens an editor, watch runs until Ctrl-C
+        static const std::set<std::string> commands = {
+            "fetch", "fetch-many", "sync", "hints", "topics", "catalog", "search", "problems",
+            "list", "submit", "run", "runtime", "hint", "cache"
+        };
+        if (args.empty() || !commands.count(args[0])) return false;
+        // fetch-many - reads slugs from stdin
+        return std::find(args.begin(), args.end(), "-") == args.end();
+    }
+}
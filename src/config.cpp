@@ -0,0 +1,121 @@
+#include "config.h"
+#include "trace.h"
+#include "utils.h"
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace leetcli {
+
+    namespace {
+        std::mutex config_mutex;
+        // Every version stays alive: leetclid threads may still hold a reference from config() while
+        // refresh_config() or save_config() moves on to a newer one. Edits are rare, so this stays tiny.
+        std::deque<Config> versions;
+        const Config* loaded = nullptr;
+        int64_t loaded_mtime = 0;
+
+        int64_t mtime_of(const std::filesystem::path& path) {
+            std::error_code ec;
+            auto t = std::filesystem::last_write_time(path, ec);
+            return ec ? 0 : static_cast<int64_t>(t.time_since_epoch().count());
+        }
+
+        std::string string_field(const nlohmann::json& json, const char* key) {
+            if (!json.contains(key) || json[key].is_null()) return "";
+            if (!json[key].is_string()) throw std::runtime_error(std::string("\"") + key + "\" must be a string");
+            return json[key].get<std::string>();
+        }
+
+        int int_field(const nlohmann::json& json, const char* key, int fallback) {
+            if (!json.contains(key) || json[key].is_null()) return fallback;
+            if (!json[key].is_number_integer() || json[key].get<int>() < 0) {
+                throw std::runtime_error(std::string("\"") + key + "\" must be a non-negative integer");
+            }
+            return json[key].get<int>();
+        }
+    }
+
+    std::filesystem::path get_config_path() {
+        return get_home() / ".leetcli/config.json";
+    }
+
+    bool config_exists() {
+        return std::filesystem::exists(get_config_path());
+    }
+
+    Config parse_config(const nlohmann::json& json) {
+        if (!json.is_object()) throw std::runtime_error("config is not a JSON object");
+
+        Config cfg;
+        cfg.raw = json;
+        cfg.problems_dir = string_field(json, "problems_dir");
+        if (cfg.problems_dir.empty()) throw std::runtime_error("\"problems_dir\" is missing");
+
+        std::string lang = string_field(json, "lang");
+        if (!lang.empty()) cfg.lang = lang; // fallback to cpp
+        if (!find_language(cfg.lang)) throw std::runtime_error("unsupported language \"" + cfg.lang + "\"");
+
+        cfg.leetcode_session = string_field(json, "leetcode_session");
+        cfg.csrf_token = string_field(json, "csrf_token");
+        cfg.gemini_key = string_field(json, "gemini_key");
+        cfg.gemini_cache_ttl_hours = int_field(json, "gemini_cache_ttl_hours", cfg.gemini_cache_ttl_hours);
+        cfg.gemini_cache_max_mb = int_field(json, "gemini_cache_max_mb", cfg.gemini_cache_max_mb);
+        return cfg;
+    }
+
+    const Config& config() {
+        std::lock_guard<std::mutex> lock(config_mutex);
+        if (loaded) return *loaded;
+
+        TraceSpan span("load config.json", "io");
+        std::filesystem::path path = get_config_path();
+        std::ifstream in(path);
+        if (!in) {
+            throw std::runtime_error("config not found. Run `leetcli init` first.");
+        }
+
+        try {
+            nlohmann::json json;
+            in >> json;
+            loaded = &versions.emplace_back(parse_config(json));
+            loaded_mtime = mtime_of(path);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("invalid config " + path.string() + ": " + e.what() +
+                                     "\nFix it or delete it and run `leetcli init` again.");
+        }
+        return *loaded;
+    }
+
+    void refresh_config() {
+        std::lock_guard<std::mutex> lock(config_mutex);
+        if (loaded && mtime_of(get_config_path()) != loaded_mtime) loaded = nullptr;
+    }
+
+    bool save_config(const Config& updated) {
+        nlohmann::json json = updated.raw.is_object() ? updated.raw : nlohmann::json::object();
+        json["problems_dir"] = updated.problems_dir;
+        json["lang"] = updated.lang;
+        auto set_or_erase = [&](const char* key, const std::string& value) {
+            if (value.empty()) json.erase(key);
+            else json[key] = value;
+        };
+        set_or_erase("leetcode_session", updated.leetcode_session);
+        set_or_erase("csrf_token", updated.csrf_token);
+        set_or_erase("gemini_key", updated.gemini_key);
+
+        std::lock_guard<std::mutex> lock(config_mutex);
+        std::filesystem::path path = get_config_path();
+        if (!write_file_atomic(path, json.dump(4))) {
+            std::cerr << "Failed to write config: " << path << "\n";
+            return false;
+        }
+        Config& saved = versions.emplace_back(updated);
+        saved.raw = json;
+        loaded = &saved;
+        loaded_mtime = mtime_of(path);
+        return true;
+    }
+}
@@ -0,0 +1,483 @@
+#include "daemon.h"
+#include "commands.h"
+#include "config.h"
+#include "leetcode_client.h"
+#include "request_context.h"
+#include "utils.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <string_view>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace leetcli {
+
+    std::filesystem::path daemon_socket_path() {
+        return get_home() / ".leetcli/leetclid.sock";
+    }
+
+#ifdef _WIN32
+    std::optional<int> forward_to_daemon(const std::vector<std::string>&) {
+        return std::nullopt;
+    }
+
+    int run_daemon() {
+        std::cerr << "leetclid needs Unix domain sockets and is not supported on Windows.\n";
+        return 1;
+    }
+
+    int handle_daemon_command(const std::vector<std::string>&) {
+        return run_daemon();
+    }
+#else
+    namespace {
+        // Every message is a frame: one tag byte, a 4-byte big-endian length, then the payload.
+        // Client -> daemon: 'a' (JSON request). Daemon -> client: '1' stdout, '2' stderr, 'x' exit code,
+        // or 'b' alone when every connection slot is taken and the client should run the command itself.
+        constexpr uint32_t kMaxRequestBytes = 1 << 20;
+        // Each client gets its own thread; past this many at once the client runs the command in-process
+        constexpr size_t kMaxConnections = 32;
+
+#ifdef MSG_NOSIGNAL
+        constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+        constexpr int kSendFlags = 0;
+#endif
+
+        std::atomic<bool> stop_requested{false}; // lock-free, so the signal handler may set it
+
+        void on_stop_signal(int) {
+            stop_requested = true;
+        }
+
+        bool send_all(int fd, const char* data, size_t len) {
+            while (len > 0) {
+                ssize_t n = send(fd, data, len, kSendFlags);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                data += n;
+                len -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        bool write_all(int fd, const char* data, size_t len) {
+            while (len > 0) {
+                ssize_t n = write(fd, data, len);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                data += n;
+                len -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        bool read_exact(int fd, char* data, size_t len) {
+            while (len > 0) {
+                ssize_t n = read(fd, data, len);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                data += n;
+                len -= static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        bool send_frame(int fd, char tag, std::string_view payload) {
+            uint32_t len = static_cast<uint32_t>(payload.size());
+            std::string frame = {tag, static_cast<char>(len >> 24), static_cast<char>(len >> 16),
+                                 static_cast<char>(len >> 8), static_cast<char>(len)};
+            frame.append(payload.data(), payload.size());
+            return send_all(fd, frame.data(), frame.size());
+        }
+
+        bool read_frame(int fd, char& tag, std::string& payload, uint32_t max_len = UINT32_MAX) {
+            unsigned char header[5];
+            if (!read_exact(fd, reinterpret_cast<char*>(header), sizeof(header))) return false;
+            uint32_t len = (uint32_t{header[1]} << 24) | (uint32_t{header[2]} << 16) | (uint32_t{header[3]} << 8) | header[4];
+            if (len > max_len) return false;
+            tag = static_cast<char>(header[0]);
+            payload.resize(len);
+            return read_exact(fd, payload.data(), len);
+        }
+
+        void set_cloexec(int fd) {
+            fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+        }
+
+        // Connected socket, or -1 when nothing is listening (including a stale socket file)
+        int connect_to_daemon() {
+            std::string path = daemon_socket_path().string();
+            sockaddr_un addr{};
+            if (path.size() >= sizeof(addr.sun_path)) return -1;
+            addr.sun_family = AF_UNIX;
+            std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+            int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0) return -1;
+            set_cloexec(fd);
+#ifdef SO_NOSIGPIPE
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+            if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                close(fd);
+                return -1;
+            }
+            return fd;
+        }
+
+        // Sends one request and relays the reply; nullopt if the daemon went away before answering
+        std::optional<int> send_request(int fd, const nlohmann::json& request) {
+            if (!send_frame(fd, 'a', request.dump())) return std::nullopt;
+
+            char tag;
+            std::string payload;
+            bool any_reply = false;
+            while (read_frame(fd, tag, payload)) {
+                any_reply = true;
+                if (tag == '1') {
+                    write_all(STDOUT_FILENO, payload.data(), payload.size());
+                } else if (tag == '2') {
+                    write_all(STDERR_FILENO, payload.data(), payload.size());
+                } else if (tag == 'x') {
+                    return std::atoi(payload.c_str());
+                } else if (tag == 'b') {
+                    return std::nullopt;
+                }
+            }
+            // A daemon that died mid-command may have done part of it; don't run it twice
+            if (any_reply) {
+                std::cerr << "❌ leetclid closed the connection before the command finished.\n";
+                return 1;
+            }
+            return std::nullopt;
+        }
+
+        // Streams one of the daemon's standard streams to the client as frames, a line at a time
+        // like a terminal would see it
+        class FrameBuf : public std::streambuf {
+        public:
+            FrameBuf(int fd, char tag, FrameBuf* flush_first = nullptr) : fd_(fd), tag_(tag), flush_first_(flush_first) {
+                setp(buf_, buf_ + sizeof(buf_));
+            }
+
+        protected:
+            int_type overflow(int_type ch) override {
+                flush_buffer();
+                if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                    *pptr() = traits_type::to_char_type(ch);
+                    pbump(1);
+                    if (traits_type::to_char_type(ch) == '\n') flush_buffer();
+                }
+                return traits_type::not_eof(ch);
+            }
+
+            std::streamsize xsputn(const char* s, std::streamsize n) override {
+                std::streamsize written = std::streambuf::xsputn(s, n);
+                if (std::memchr(s, '\n', static_cast<size_t>(n))) flush_buffer();
+                return written;
+            }
+
+            int sync() override {
+                flush_buffer();
+                return 0; // a client that hung up must not leave the stream in a failed state
+            }
+
+        private:
+            void flush_buffer() {
+                // stderr output flushes pending stdout first so the client sees them in order
+                if (flush_first_) flush_first_->flush_buffer();
+                size_t len = static_cast<size_t>(pptr() - pbase());
+                if (len && !broken_) broken_ = !send_frame(fd_, tag_, std::string_view(pbase(), len));
+                setp(buf_, buf_ + sizeof(buf_));
+            }
+
+            int fd_;
+            char tag_;
+            FrameBuf* flush_first_;
+            bool broken_ = false;
+            char buf_[4096];
+        };
+
+        struct DaemonStats {
+            std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+            std::atomic<uint64_t> served{0};
+
+            // Connections being served; stopping waits for them to finish
+            std::mutex mutex;
+            std::condition_variable idle;
+            size_t active = 0;
+        };
+
+        // Runs one request on the connection's own thread; returns true when the client asked the daemon to stop
+        bool serve(int fd, DaemonStats& stats) {
+            timeval timeout{5, 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            char tag;
+            std::string payload;
+            if (!read_frame(fd, tag, payload, kMaxRequestBytes) || tag != 'a') return false;
+            nlohmann::json request = nlohmann::json::parse(payload, nullptr, false);
+            if (request.is_discarded() || !request.is_object()) return false;
+
+            std::string control = request.value("control", "");
+            if (control == "stop") {
+                send_frame(fd, '1', "leetclid stopped.\n");
+                send_frame(fd, 'x', "0");
+                return true;
+            }
+            if (control == "status") {
+                auto uptime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - stats.started);
+                size_t active;
+                {
+                    std::lock_guard<std::mutex> lock(stats.mutex);
+                    active = stats.active - 1; // not counting this status request
+                }
+                send_frame(fd, '1', "leetclid running (pid " + std::to_string(getpid()) + ", up " + std::to_string(uptime.count()) +
+                                    " s, " + std::to_string(stats.served) + " commands served, " + std::to_string(active) +
+                                    " running)\n");
+                send_frame(fd, 'x', "0");
+                return false;
+            }
+
+            std::vector<std::string> args;
+            std::string cwd;
+            try {
+                args = request.value("args", std::vector<std::string>{});
+                cwd = request.value("cwd", "");
+            } catch (const std::exception&) {
+                return false; // not from our client
+            }
+            ++stats.served;
+
+            // std::cout/std::cerr on this thread (and on threads the command starts) reach this client only.
+            // The process cwd is left alone: relative paths resolve against the request's cwd instead.
+            FrameBuf out(fd, '1');
+            FrameBuf err(fd, '2', &out);
+            RequestContext context;
+            context.out = &out;
+            context.err = &err;
+            context.cwd = cwd;
+            RequestScope scope(&context);
+
+            int code;
+            try {
+                refresh_config();
+                code = run_command(args);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+                code = 1;
+            } catch (...) {
+                std::cerr << "Error: unexpected failure\n";
+                code = 1;
+            }
+
+            std::cout.flush();
+            std::cerr.flush();
+            send_frame(fd, 'x', std::to_string(code));
+            return false;
+        }
+
+        int send_control(const std::string& control) {
+            int fd = connect_to_daemon();
+            if (fd < 0) {
+                std::cout << "leetclid is not running.\n";
+                return 1;
+            }
+            auto code = send_request(fd, {{"control", control}});
+            close(fd);
+            return code.value_or(1);
+        }
+
+        // fork + exec leetclid (next to this binary, else from PATH), detached, logging to ~/.leetcli/leetclid.log
+        int start_daemon() {
+            if (int fd = connect_to_daemon(); fd >= 0) {
+                close(fd);
+                std::cout << "leetclid is already running.\n";
+                return 0;
+            }
+
+            std::filesystem::path log_path = get_home() / ".leetcli/leetclid.log";
+            std::error_code ec;
+            std::filesystem::create_directories(log_path.parent_path(), ec);
+            std::filesystem::path sibling = std::filesystem::read_symlink("/proc/self/exe", ec).parent_path() / "leetclid";
+            bool has_sibling = !ec && std::filesystem::exists(sibling, ec);
+
+            pid_t pid = fork();
+            if (pid < 0) {
+                std::cerr << "❌ fork failed: " << std::strerror(errno) << "\n";
+                return 1;
+            }
+            if (pid == 0) {
+                setsid();
+                int null_fd = open("/dev/null", O_RDONLY);
+                int log_fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0600);
+                if (null_fd >= 0) dup2(null_fd, STDIN_FILENO);
+                if (log_fd >= 0) {
+                    dup2(log_fd, STDOUT_FILENO);
+                    dup2(log_fd, STDERR_FILENO);
+                }
+                if (has_sibling) execl(sibling.c_str(), "leetclid", static_cast<char*>(nullptr));
+                execlp("leetclid", "leetclid", static_cast<char*>(nullptr));
+                _exit(127);
+            }
+
+            // Wait for the socket so the next command already goes through the daemon
+            for (int i = 0; i < 100; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                if (int fd = connect_to_daemon(); fd >= 0) {
+                    close(fd);
+                    std::cout << "✅ leetclid started (pid " << pid << ").\n";
+                    return 0;
+                }
+            }
+            std::cerr << "❌ leetclid did not come up; see " << log_path << "\n";
+            return 1;
+        }
+    }
+
+    std::optional<int> forward_to_daemon(const std::vector<std::string>& args) {
+        int fd = connect_to_daemon();
+        if (fd < 0) return std::nullopt;
+
+        std::error_code ec;
+        nlohmann::json request = {{"args", args}, {"cwd", std::filesystem::current_path(ec).string()}};
+        auto code = send_request(fd, request);
+        close(fd);
+        return code;
+    }
+
+    int run_daemon() {
+        if (int fd = connect_to_daemon(); fd >= 0) {
+            close(fd);
+            std::cerr << "leetclid is already running.\n";
+            return 1;
+        }
+
+        std::filesystem::path path = daemon_socket_path();
+        sockaddr_un addr{};
+        if (path.string().size() >= sizeof(addr.sun_path)) {
+            std::cerr << "Socket path too long: " << path << "\n";
+            return 1;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.string().size() + 1);
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        unlink(path.c_str()); // left behind by a daemon that didn't shut down cleanly
+
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) {
+            std::cerr << "socket failed: " << std::strerror(errno) << "\n";
+            return 1;
+        }
+        set_cloexec(listener); // the local runner forks; its children must not hold the socket
+
+        // Only this user may talk to the daemon: it acts with their LeetCode session
+        mode_t old_umask = umask(0077);
+        int bound = bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        umask(old_umask);
+        if (bound != 0 || listen(listener, 16) != 0) {
+            std::cerr << "Could not listen on " << path << ": " << std::strerror(errno) << "\n";
+            close(listener);
+            return 1;
+        }
+
+        std::signal(SIGPIPE, SIG_IGN);
+        struct sigaction action{};
+        action.sa_handler = on_stop_signal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = 0; // no SA_RESTART: accept() must return so the loop sees the flag
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+
+        // Connection threads leave SIGINT/SIGTERM to this one, so they interrupt accept()
+        sigset_t stop_signals;
+        sigemptyset(&stop_signals);
+        sigaddset(&stop_signals, SIGINT);
+        sigaddset(&stop_signals, SIGTERM);
+
+        // Warm up: parse config and set up curl before the first command arrives
+        try {
+            config();
+            client();
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: " << e.what() << "\n";
+        }
+
+        std::cout << "leetclid listening on " << path.string() << std::endl;
+        route_output_per_thread();
+        // Static: detached connection threads still touch it while they finish up
+        static DaemonStats stats;
+        while (!stop_requested) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd < 0) continue; // EINTR from a stop signal, or a client that gave up
+            set_cloexec(fd);
+            if (stop_requested) {
+                close(fd);
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> lock(stats.mutex);
+                if (stats.active >= kMaxConnections) {
+                    send_frame(fd, 'b', "");
+                    close(fd);
+                    continue;
+                }
+                ++stats.active;
+            }
+
+            pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+            std::thread([fd] {
+                bool stop = serve(fd, stats);
+                close(fd);
+                if (stop) {
+                    stop_requested = true;
+                    // Wake accept() so the loop sees the flag
+                    if (int wake = connect_to_daemon(); wake >= 0) close(wake);
+                }
+                std::lock_guard<std::mutex> lock(stats.mutex);
+                --stats.active;
+                stats.idle.notify_all();
+            }).detach();
+            pthread_sigmask(SIG_UNBLOCK, &stop_signals, nullptr);
+        }
+
+        close(listener);
+        unlink(path.c_str());
+        {
+            // Let commands already running finish before the process goes away
+            std::unique_lock<std::mutex> lock(stats.mutex);
+            stats.idle.wait(lock, [&] { return stats.active == 0; });
+        }
+        std::cout << "leetclid stopped after " << stats.served << " commands." << std::endl;
+        return 0;
+    }
+
+    int handle_daemon_command(const std::vector<std::string>& args) {
+        std::string sub = args.size() > 1 ? args[1] : "";
+        if (sub == "start") return start_daemon();
+        if (sub == "stop") return send_control("stop");
+        if (sub == "status") return send_control("status");
+        std::cerr << "Usage: leetcli daemon start|stop|status\n";
+        return 1;
+    }
+#endif
+}
@@ -0,0 +1,50 @@
+#include "executor.h"
+#include <algorithm>
+
+namespace leetcli {
+
+    Executor::Executor(unsigned threads) {
+        for (unsigned i = 0; i < std::max(1u, threads); ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    Executor::~Executor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    void Executor::post(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(job));
+        }
+        ready_.notify_one();
+    }
+
+    void Executor::work() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            // A job a waiting thread already ran inline is a no-op here
+            job();
+        }
+    }
+
+    Executor& shared_executor() {
+        // Never freed: leetclid's detached client threads may still submit during static destruction.
+        // Mostly network and disk waits, so a few more threads than cores.
+        static Executor* executor = new Executor(std::max(4u, std::thread::hardware_concurrency()));
+        return *executor;
+    }
+}
@@ -0,0 +1,307 @@
+#include "gemini.h"
+#include "config.h"
+#include "leetcode_client.h"
+#include "request_context.h"
+#include "trace.h"
+#include "transport.h"
+#include "utils.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace leetcli {
+
+    namespace {
+        const std::string kModel = "gemini-2.0-flash";
+
+        volatile std::sig_atomic_t cancel_requested = 0;
+
+        void on_sigint(int) {
+            cancel_requested = 1;
+        }
+
+        // LEETCLI_GEMINI_ENDPOINT points the client at a local stub server
+        std::string endpoint() {
+            const char* env = std::getenv("LEETCLI_GEMINI_ENDPOINT");
+            return env && *env ? env : "https://generativelanguage.googleapis.com/v1beta";
+        }
+
+        std::string cache_key(const std::string& body) {
+            return hash_hex(kModel + "\n" + body);
+        }
+
+        bool cache_enabled(const Config& cfg, const GeminiOptions& options) {
+            return options.use_cache && cfg.gemini_cache_ttl_hours > 0 && cfg.gemini_cache_max_mb > 0;
+        }
+
+        std::optional<std::string> load_api_key(std::string& error) {
+            // Cassettes store the key redacted, so replay needs none
+            if (transport_mode() == TransportMode::Replay) return std::string("REDACTED");
+            try {
+                return get_gemini_key();
+            } catch (const std::exception&) {
+                error = "No Gemini API key found. Use `leetcli config set-gemini-key <your-key>` first.";
+                return std::nullopt;
+            }
+        }
+
+        std::filesystem::path cache_dir() {
+            return get_home() / ".leetcli/cache/gemini";
+        }
+
+        std::optional<std::string> lookup(const std::string& key, int ttl_hours) {
+            std::ifstream in(cache_dir() / (key + ".json"));
+            if (!in) return std::nullopt;
+            nlohmann::json j = nlohmann::json::parse(in, nullptr, false);
+            if (j.is_discarded() || !j.is_object() || !j.contains("text")) return std::nullopt;
+
+            int64_t age = static_cast<int64_t>(std::time(nullptr)) - j.value("created", int64_t{0});
+            if (age > static_cast<int64_t>(ttl_hours) * 3600) return std::nullopt;
+            return j["text"].get<std::string>();
+        }
+
+        // Oldest entries go first once the directory is over the cap
+        void enforce_size_cap(uint64_t max_bytes) {
+            struct Entry {
+                std::filesystem::file_time_type mtime;
+                uint64_t size;
+                std::filesystem::path path;
+            };
+            std::vector<Entry> entries;
+            uint64_t total = 0;
+            std::error_code ec;
+            for (const auto& file : std::filesystem::directory_iterator(cache_dir(), ec)) {
+                if (!file.is_regular_file()) continue;
+                uint64_t size = file.file_size(ec);
+                entries.push_back({file.last_write_time(ec), size, file.path()});
+                total += size;
+            }
+            if (total <= max_bytes) return;
+
+            std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+            for (const auto& e : entries) {
+                if (total <= max_bytes) break;
+                std::filesystem::remove(e.path, ec);
+                total -= e.size;
+            }
+        }
+
+        void store(const std::string& key, const std::string& text, int max_mb) {
+            nlohmann::json j = {{"model", kModel}, {"created", static_cast<int64_t>(std::time(nullptr))}, {"text", text}};
+            if (write_file_atomic(cache_dir() / (key + ".json"), j.dump())) {
+                enforce_size_cap(static_cast<uint64_t>(max_mb) * 1024 * 1024);
+            }
+        }
+    }
+
+    SseParser::SseParser(std::function<void(const std::string&)> on_event) : on_event_(std::move(on_event)) {}
+
+    void SseParser::feed(std::string_view bytes) {
+        for (char c : bytes) {
+            if (c == '\n') {
+                if (!line_.empty() && line_.back() == '\r') line_.pop_back();
+                handle_line(line_);
+                line_.clear();
+            } else {
+                line_ += c;
+            }
+        }
+    }
+
+    void SseParser::finish() {
+        if (!line_.empty()) {
+            handle_line(line_);
+            line_.clear();
+        }
+        handle_line("");
+    }
+
+    void SseParser::handle_line(std::string_view line) {
+        if (line.empty()) {
+            // A blank line ends the event
+            if (has_data_) on_event_(data_);
+            data_.clear();
+            has_data_ = false;
+            return;
+        }
+        if (line[0] == ':') return; // comment / keep-alive
+        if (line.compare(0, 5, "data:") != 0) return; // event:, id:, retry: carry nothing we use
+
+        std::string_view value = line.substr(5);
+        if (!value.empty() && value[0] == ' ') value.remove_prefix(1);
+        if (has_data_) data_ += '\n';
+        data_.append(value.data(), value.size());
+        has_data_ = true;
+    }
+
+    void decode_stream_event(const std::string& data, const std::function<void(const std::string&)>& on_text,
+                             std::string& error) {
+        auto chunk = nlohmann::json::parse(data, nullptr, false);
+        if (chunk.is_discarded() || !chunk.is_object()) return;
+        if (chunk.contains("error")) {
+            const auto& details = chunk["error"];
+            if (details.is_object() && details.contains("message") && details["message"].is_string()) {
+                error = details["message"].get<std::string>();
+            } else {
+                error = details.is_string() ? details.get<std::string>() : details.dump();
+            }
+            return;
+        }
+        if (!chunk.contains("candidates") || !chunk["candidates"].is_array() || chunk["candidates"].empty()) return;
+        const auto& candidate = chunk["candidates"][0];
+        if (!candidate.is_object() || !candidate.contains("content") || !candidate["content"].is_object()) return;
+        const auto& content = candidate["content"];
+        if (!content.contains("parts") || !content["parts"].is_array()) return;
+        for (const auto& part : content["parts"]) {
+            if (!part.is_object() || !part.contains("text") || !part["text"].is_string()) continue;
+            const std::string& piece = part["text"].get_ref<const std::string&>();
+            if (!piece.empty()) on_text(piece);
+        }
+    }
+
+    std::optional<std::string> gemini_generate(const nlohmann::json& payload, std::string& error,
+                                               const GeminiOptions& options) {
+        const Config& cfg = config();
+        bool cache = cache_enabled(cfg, options);
+        std::string body = payload.dump();
+        std::string key = cache_key(body);
+
+        if (cache) {
+            if (auto hit = lookup(key, cfg.gemini_cache_ttl_hours)) return hit;
+        }
+
+        auto api_key = load_api_key(error);
+        if (!api_key) return std::nullopt;
+
+        std::string url = endpoint() + "/models/" + kModel + ":generateContent?key=" + *api_key;
+        cpr::Response r = client().post_external(url, body);
+        if (r.status_code != 200) {
+            error = "Gemini API call failed: " + std::to_string(r.status_code) + "\n" + r.text;
+            return std::nullopt;
+        }
+
+        std::string text;
+        try {
+            auto response_json = nlohmann::json::parse(r.text);
+            text = response_json["candidates"][0]["content"]["parts"][0]["text"].get<std::string>();
+        } catch (const std::exception& e) {
+            error = std::string("Failed to parse Gemini response: ") + e.what();
+            return std::nullopt;
+        }
+
+        if (cache) store(key, text, cfg.gemini_cache_max_mb);
+        return text;
+    }
+
+    std::optional<std::string> gemini_stream(const nlohmann::json& payload,
+                                             const std::function<void(std::string_view)>& on_text,
+                                             std::string& error, const GeminiOptions& options,
+                                             GeminiStreamStats* stats) {
+        GeminiStreamStats local_stats;
+        GeminiStreamStats& st = stats ? *stats : local_stats;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = [&] {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        };
+
+        const Config& cfg = config();
+        bool cache = cache_enabled(cfg, options);
+        std::string body = payload.dump();
+        std::string key = cache_key(body);
+
+        if (cache) {
+            if (auto hit = lookup(key, cfg.gemini_cache_ttl_hours)) {
+                st.from_cache = true;
+                st.first_token = st.total = elapsed();
+                on_text(*hit);
+                return hit;
+            }
+        }
+
+        auto api_key = load_api_key(error);
+        if (!api_key) return std::nullopt;
+
+        std::string text;
+        std::string raw; // kept for error messages; the stream itself isn't buffered
+        std::string stream_error;
+        SseParser parser([&](const std::string& data) {
+            decode_stream_event(data, [&](const std::string& piece) {
+                if (!st.first_token) st.first_token = elapsed();
+                text += piece;
+                on_text(piece);
+            }, stream_error);
+        });
+
+        // The write callback consumes the body, so a recording keeps its own full copy for the cassette
+        const bool recording = transport_mode() == TransportMode::Record;
+        std::string recorded;
+
+        // A one-off session: the write callback would otherwise stick to the shared client's handle
+        cpr::Session session;
+        std::string url = endpoint() + "/models/" + kModel + ":streamGenerateContent?alt=sse&key=" + *api_key;
+        session.SetUrl(cpr::Url{url});
+        session.SetHeader(cpr::Header{{"Content-Type", "application/json"}, {"Accept", "text/event-stream"}});
+        session.SetBody(cpr::Body{body});
+        session.SetConnectTimeout(cpr::ConnectTimeout{std::chrono::seconds(10)});
+        session.SetTimeout(cpr::Timeout{std::chrono::seconds(120)});
+        // Ctrl-C cancels in the CLI. Inside leetclid the signal handlers belong to the daemon and other
+        // requests share the flag, so a request never touches either.
+        const bool owns_sigint = current_request() == nullptr;
+        auto cancelled = [owns_sigint] { return owns_sigint && cancel_requested != 0; };
+        session.SetWriteCallback(cpr::WriteCallback{[&](std::string_view data, intptr_t) {
+            if (raw.size() < 16 * 1024) raw.append(data.data(), std::min<size_t>(data.size(), 16 * 1024));
+            if (recording) recorded.append(data.data(), data.size());
+            parser.feed(data);
+            return !cancelled();
+        }});
+        // Also polled while no bytes arrive, so Ctrl-C works before the first token too
+        session.SetProgressCallback(cpr::ProgressCallback{[&](cpr::cpr_pf_arg_t, cpr::cpr_pf_arg_t, cpr::cpr_pf_arg_t,
+                                                              cpr::cpr_pf_arg_t, intptr_t) {
+            return !cancelled();
+        }});
+
+        if (owns_sigint) cancel_requested = 0;
+        cpr::Response r;
+        if (auto replayed = replay_exchange("POST", url, body)) {
+            r = std::move(*replayed);
+            raw = r.text.substr(0, 16 * 1024);
+            parser.feed(r.text);
+        } else {
+            auto previous = owns_sigint ? std::signal(SIGINT, on_sigint) : SIG_ERR;
+            r = session.Post();
+            trace_http("POST", url, session.GetCurlHolder()->handle, r.status_code);
+            if (owns_sigint) std::signal(SIGINT, previous == SIG_ERR ? SIG_DFL : previous);
+            if (recording && !cancelled()) {
+                r.text = std::move(recorded);
+                record_exchange("POST", url, body, r);
+            }
+        }
+        parser.finish();
+        st.total = elapsed();
+
+        if (cancelled()) {
+            st.cancelled = true;
+            error = "Cancelled.";
+            return std::nullopt;
+        }
+        if (r.status_code != 200) {
+            error = "Gemini API call failed: " + std::to_string(r.status_code) + "\n" + (r.error ? r.error.message : raw);
+            return std::nullopt;
+        }
+        if (!stream_error.empty()) {
+            error = "Gemini reported an error: " + stream_error;
+            return std::nullopt;
+        }
+        if (r.error) {
+            error = "Gemini stream failed: " + r.error.message;
+            return std::nullopt;
+        }
+
+        if (cache && !text.empty()) store(key, text, cfg.gemini_cache_max_mb);
+        return text;
+    }
+}
@@ -0,0 +1,325 @@
+#include "utils.h"
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+// Single-pass HTML -> Markdown conversion for LeetCode problem statements.
+// Tags are tokenized in place and rewritten straight into one output buffer;
+// nothing is copied or re-scanned per rule.
+
+namespace leetcli {
+
+    namespace {
+        struct Entity {
+            const char* name;
+            const char* utf8;
+        };
+
+        // Sorted by name for binary search
+        constexpr Entity kEntities[] = {
+            {"Alpha", "Α"}, {"Beta", "Β"}, {"Delta", "Δ"}, {"Gamma", "Γ"}, {"Lambda", "Λ"}, {"Omega", "Ω"},
+            {"Phi", "Φ"}, {"Pi", "Π"}, {"Prime", "″"}, {"Psi", "Ψ"}, {"Sigma", "Σ"}, {"Theta", "Θ"},
+            {"alpha", "α"}, {"amp", "&"}, {"and", "∧"}, {"ang", "∠"}, {"apos", "'"}, {"asymp", "≈"},
+            {"beta", "β"}, {"bull", "•"}, {"cap", "∩"}, {"cent", "¢"}, {"chi", "χ"}, {"circ", "ˆ"},
+            {"cong", "≅"}, {"copy", "©"}, {"cup", "∪"}, {"dArr", "⇓"}, {"darr", "↓"}, {"deg", "°"},
+            {"delta", "δ"}, {"divide", "÷"}, {"empty", "∅"}, {"emsp", " "}, {"ensp", " "},
+            {"epsilon", "ε"}, {"equiv", "≡"}, {"eta", "η"}, {"euro", "€"}, {"exist", "∃"},
+            {"forall", "∀"}, {"frac12", "½"}, {"frac14", "¼"}, {"frac34", "¾"}, {"gamma", "γ"},
+            {"ge", "≥"}, {"gt", ">"}, {"hArr", "⇔"}, {"harr", "↔"}, {"hellip", "…"}, {"infin", "∞"},
+            {"int", "∫"}, {"iota", "ι"}, {"isin", "∈"}, {"kappa", "κ"}, {"lArr", "⇐"}, {"lambda", "λ"},
+            {"lang", "⟨"}, {"laquo", "«"}, {"larr", "←"}, {"lceil", "⌈"}, {"ldquo", "“"}, {"le", "≤"},
+            {"lfloor", "⌊"}, {"lowast", "∗"}, {"lsaquo", "‹"}, {"lsquo", "‘"}, {"lt", "<"},
+            {"mdash", "—"}, {"micro", "µ"}, {"middot", "·"}, {"minus", "−"}, {"mu", "μ"},
+            {"nabla", "∇"}, {"nbsp", " "}, {"ndash", "–"}, {"ne", "≠"}, {"ni", "∋"}, {"not", "¬"},
+            {"notin", "∉"}, {"nsub", "⊄"}, {"nu", "ν"}, {"omega", "ω"}, {"oplus", "⊕"}, {"or", "∨"},
+            {"otimes", "⊗"}, {"para", "¶"}, {"part", "∂"}, {"perp", "⊥"}, {"phi", "φ"}, {"pi", "π"},
+            {"plusmn", "±"}, {"pound", "£"}, {"prime", "′"}, {"prod", "∏"}, {"prop", "∝"}, {"psi", "ψ"},
+            {"quot", "\""}, {"rArr", "⇒"}, {"radic", "√"}, {"rang", "⟩"}, {"raquo", "»"}, {"rarr", "→"},
+            {"rceil", "⌉"}, {"rdquo", "”"}, {"reg", "®"}, {"rfloor", "⌋"}, {"rho", "ρ"},
+            {"rsaquo", "›"}, {"rsquo", "’"}, {"sdot", "⋅"}, {"sect", "§"}, {"shy", ""}, {"sigma", "σ"},
+            {"sim", "∼"}, {"sub", "⊂"}, {"sube", "⊆"}, {"sum", "∑"}, {"sup", "⊃"}, {"sup1", "¹"},
+            {"sup2", "²"}, {"sup3", "³"}, {"supe", "⊇"}, {"tau", "τ"}, {"there4", "∴"}, {"theta", "θ"},
+            {"thinsp", " "}, {"times", "×"}, {"trade", "™"}, {"uArr", "⇑"}, {"uarr", "↑"},
+            {"upsilon", "υ"}, {"xi", "ξ"}, {"yen", "¥"}, {"zeta", "ζ"}, {"zwj", ""}, {"zwnj", ""},
+        };
+
+        const char* lookup_entity(std::string_view name) {
+            auto it = std::lower_bound(std::begin(kEntities), std::end(kEntities), name,
+                                       [](const Entity& e, std::string_view n) { return std::string_view(e.name) < n; });
+            if (it != std::end(kEntities) && std::string_view(it->name) == name) return it->utf8;
+            return nullptr;
+        }
+
+        void append_utf8(std::string& out, unsigned long cp) {
+            if (cp == 0xA0) cp = ' '; // &#160; behaves like &nbsp;
+            if (cp < 0x80) {
+                out += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x110000) {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+        // Decodes the entity starting at html[i] == '&'. Returns the number of bytes consumed, 0 if not an entity.
+        size_t decode_entity(std::string_view html, size_t i, std::string& out) {
+            size_t semi = html.find(';', i + 1);
+            if (semi == std::string_view::npos || semi - i > 12) return 0;
+            std::string_view body = html.substr(i + 1, semi - i - 1);
+            if (body.empty()) return 0;
+
+            if (body[0] == '#') {
+                bool hex = body.size() > 1 && (body[1] == 'x' || body[1] == 'X');
+                std::string_view digits = body.substr(hex ? 2 : 1);
+                if (digits.empty()) return 0;
+                unsigned long cp = 0;
+                for (char c : digits) {
+                    int v;
+                    if (c >= '0' && c <= '9') v = c - '0';
+                    else if (hex && c >= 'a' && c <= 'f') v = c - 'a' + 10;
+                    else if (hex && c >= 'A' && c <= 'F') v = c - 'A' + 10;
+                    else return 0;
+                    cp = cp * (hex ? 16 : 10) + v;
+                    if (cp > 0x10FFFF) return 0;
+                }
+                append_utf8(out, cp);
+                return semi - i + 1;
+            }
+
+            if (const char* utf8 = lookup_entity(body)) {
+                out += utf8;
+                return semi - i + 1;
+            }
+            return 0;
+        }
+
+        struct Tag {
+            std::string_view name; // lower-cased into a small buffer
+            std::string_view attrs;
+            bool closing = false;
+            size_t end = 0;        // index just past '>'
+        };
+
+        bool is_alpha(char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        // Parses the tag starting at html[i] == '<'; buf receives the lower-cased name.
+        bool parse_tag(std::string_view html, size_t i, Tag& tag, char (&buf)[16]) {
+            size_t j = i + 1;
+            tag.closing = j < html.size() && html[j] == '/';
+            if (tag.closing) ++j;
+            if (j >= html.size() || !is_alpha(html[j])) return false;
+
+            size_t len = 0;
+            while (j < html.size() && (is_alpha(html[j]) || (html[j] >= '0' && html[j] <= '9'))) {
+                if (len < sizeof(buf)) buf[len] = static_cast<char>(html[j] | 0x20);
+                ++len;
+                ++j;
+            }
+            size_t close = html.find('>', j);
+            if (close == std::string_view::npos) return false;
+
+            tag.name = std::string_view(buf, std::min(len, sizeof(buf)));
+            tag.attrs = html.substr(j, close - j);
+            tag.end = close + 1;
+            return true;
+        }
+
+        std::string_view attribute(std::string_view attrs, std::string_view name) {
+            size_t pos = 0;
+            while ((pos = attrs.find(name, pos)) != std::string_view::npos) {
+                size_t k = pos + name.size();
+                bool starts_word = pos == 0 || attrs[pos - 1] == ' ' || attrs[pos - 1] == '\t' || attrs[pos - 1] == '\n';
+                while (k < attrs.size() && attrs[k] == ' ') ++k;
+                if (starts_word && k < attrs.size() && attrs[k] == '=') {
+                    ++k;
+                    while (k < attrs.size() && attrs[k] == ' ') ++k;
+                    if (k < attrs.size() && (attrs[k] == '"' || attrs[k] == '\'')) {
+                        char quote = attrs[k];
+                        size_t end = attrs.find(quote, k + 1);
+                        if (end == std::string_view::npos) return {};
+                        return attrs.substr(k + 1, end - k - 1);
+                    }
+                    size_t end = k;
+                    while (end < attrs.size() && attrs[end] != ' ' && attrs[end] != '/') ++end;
+                    return attrs.substr(k, end - k);
+                }
+                pos = k;
+            }
+            return {};
+        }
+
+        bool starts_with_tag(std::string_view html, size_t i, std::string_view tag) {
+            if (i + tag.size() > html.size()) return false;
+            for (size_t k = 0; k < tag.size(); ++k) {
+                if ((html[i + k] | 0x20) != (tag[k] | 0x20)) return false;
+            }
+            char next = i + tag.size() < html.size() ? html[i + tag.size()] : '>';
+            return next == '>' || next == ' ' || next == '/' || next == '\t' || next == '\n';
+        }
+
+        struct ListState {
+            bool ordered;
+            int counter;
+        };
+    }
+
+    std::string html_to_text(const std::string &html_str) {
+        std::string_view html(html_str);
+        std::string out;
+        out.reserve(html.size());
+
+        std::vector<ListState> lists;
+        bool in_fenced_code = false;
+        size_t table_row = 0;
+        size_t header_cells = 0;
+        size_t row_cells = 0;
+
+        size_t i = 0;
+        while (i < html.size()) {
+            char c = html[i];
+
+            if (c == '&') {
+                if (size_t used = decode_entity(html, i, out)) {
+                    i += used;
+                } else {
+                    out += c;
+                    ++i;
+                }
+                continue;
+            }
+
+            if (c != '<') {
+                size_t next = html.find_first_of("<&", i);
+                if (next == std::string_view::npos) next = html.size();
+                out.append(html.data() + i, next - i);
+                i = next;
+                continue;
+            }
+
+            // Comments and doctypes produce nothing
+            if (html.compare(i, 4, "<!--") == 0) {
+                size_t end = html.find("-->", i + 4);
+                i = end == std::string_view::npos ? html.size() : end + 3;
+                continue;
+            }
+            if (i + 1 < html.size() && (html[i + 1] == '!' || html[i + 1] == '?')) {
+                size_t end = html.find('>', i);
+                i = end == std::string_view::npos ? html.size() : end + 1;
+                continue;
+            }
+
+            char buf[16];
+            Tag tag;
+            if (!parse_tag(html, i, tag, buf)) {
+                out += c; // a bare '<' in text, e.g. "a < b"
+                ++i;
+                continue;
+            }
+            i = tag.end;
+            std::string_view name = tag.name;
+
+            if (name.size() == 2 && name[0] == 'h' && name[1] >= '1' && name[1] <= '6') {
+                if (tag.closing) out += '\n';
+                else out.append(static_cast<size_t>(name[1] - '0'), '#').append(" ");
+            } else if (name == "p") {
+                out += '\n';
+            } else if (name == "br") {
+                out += '\n';
+            } else if (name == "ul" || name == "ol") {
+                if (tag.closing) {
+                    if (!lists.empty()) lists.pop_back();
+                } else {
+                    // A nested list starts on its own line under the parent item
+                    if (!lists.empty() && !out.empty() && out.back() != '\n') out += '\n';
+                    lists.push_back({name == "ol", 0});
+                }
+            } else if (name == "li") {
+                if (tag.closing) {
+                    out += '\n';
+                } else {
+                    size_t depth = lists.empty() ? 0 : lists.size() - 1;
+                    out.append(depth * 2, ' ');
+                    if (!lists.empty() && lists.back().ordered) {
+                        out += ' ';
+                        out += std::to_string(++lists.back().counter);
+                        out += ". ";
+                    } else {
+                        out += " - ";
+                    }
+                }
+            } else if (name == "pre") {
+                if (!tag.closing && starts_with_tag(html, i, "<code")) {
+                    // <pre><code> becomes a fenced block; the inner <code> is consumed here
+                    size_t code_end = html.find('>', i);
+                    i = code_end == std::string_view::npos ? html.size() : code_end + 1;
+                    out += "```\n";
+                    in_fenced_code = true;
+                } else if (!tag.closing) {
+                    out += '\n';
+                }
+            } else if (name == "code") {
+                if (tag.closing && in_fenced_code && starts_with_tag(html, i, "</pre")) {
+                    size_t pre_end = html.find('>', i);
+                    i = pre_end == std::string_view::npos ? html.size() : pre_end + 1;
+                    out += "\n```";
+                    in_fenced_code = false;
+                } else if (!in_fenced_code) {
+                    out += '`';
+                }
+            } else if (name == "b" || name == "strong") {
+                out += "**";
+            } else if (name == "em" || name == "i") {
+                out += '*';
+            } else if (name == "sup") {
+                if (!tag.closing) out += '^';
+            } else if (name == "sub") {
+                if (!tag.closing) out += '_';
+            } else if (name == "img") {
+                std::string_view alt = attribute(tag.attrs, "alt");
+                std::string_view src = attribute(tag.attrs, "src");
+                out += "![";
+                out.append(alt.data(), alt.size());
+                out += "](";
+                out.append(src.data(), src.size());
+                out += ')';
+            } else if (name == "table") {
+                out += '\n';
+                table_row = 0;
+            } else if (name == "tr") {
+                if (!tag.closing) {
+                    out += '|';
+                    row_cells = 0;
+                } else {
+                    out += '\n';
+                    // Markdown needs a separator after the first row to make it a table
+                    if (table_row == 0) {
+                        header_cells = row_cells;
+                        for (size_t k = 0; k < header_cells; ++k) out += k == 0 ? "|---|" : "---|";
+                        if (header_cells) out += '\n';
+                    }
+                    ++table_row;
+                }
+            } else if (name == "td" || name == "th") {
+                if (!tag.closing) {
+                    out += ' ';
+                    ++row_cells;
+                } else {
+                    out += " |";
+                }
+            }
+            // Any other tag (div, span, font, ...) is dropped, keeping its text
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,5 @@
+#include "daemon.h"
+
+int main() {
+    return leetcli::run_daemon();
+}
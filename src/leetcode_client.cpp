@@ -0,0 +1,134 @@
+#include "leetcode_client.h"
+#include "trace.h"
+#include "transport.h"
+#include "utils.h"
+#include <curl/curl.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace leetcli {
+
+    namespace {
+        const char* kUserAgent =
+            "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/114.0.0.0 Safari/537.36";
+
+        std::mutex share_locks[CURL_LOCK_DATA_LAST];
+
+        void lock_share(CURL*, curl_lock_data data, curl_lock_access, void*) {
+            share_locks[data].lock();
+        }
+
+        void unlock_share(CURL*, curl_lock_data data, void*) {
+            share_locks[data].unlock();
+        }
+
+        std::atomic<std::int64_t> transfer_rate_limit{0};
+
+        // Created once and intentionally never freed: thread-local sessions may outlive any static owner
+        CURLSH* shared_handle() {
+            static CURLSH* share = [] {
+                curl_global_init(CURL_GLOBAL_DEFAULT);
+                CURLSH* sh = curl_share_init();
+                curl_share_setopt(sh, CURLSHOPT_LOCKFUNC, lock_share);
+                curl_share_setopt(sh, CURLSHOPT_UNLOCKFUNC, unlock_share);
+                curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+                curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+                curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+                return sh;
+            }();
+            return share;
+        }
+    }
+
+    LeetCodeClient::LeetCodeClient() {
+        configure(get_session_);
+        configure(post_session_);
+    }
+
+    void LeetCodeClient::configure(cpr::Session& session) {
+        session.SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_TLS});
+        session.SetConnectTimeout(cpr::ConnectTimeout{std::chrono::seconds(10)});
+        session.SetTimeout(cpr::Timeout{std::chrono::seconds(60)});
+
+        CURL* handle = session.GetCurlHolder()->handle;
+        curl_easy_setopt(handle, CURLOPT_SHARE, shared_handle());
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    }
+
+    void LeetCodeClient::apply_rate_limit() {
+        std::int64_t limit = transfer_rate_limit.load(std::memory_order_relaxed);
+        if (limit == rate_limit_) return;
+        // Both sessions get the new limit; 0 clears it
+        get_session_.SetLimitRate(cpr::LimitRate{limit, limit});
+        post_session_.SetLimitRate(cpr::LimitRate{limit, limit});
+        rate_limit_ = limit;
+    }
+
+    cpr::Header LeetCodeClient::leetcode_headers(Auth auth, const std::string& referer) {
+        cpr::Header header{
+            {"Content-Type", "application/json"},
+            {"User-Agent", kUserAgent},
+            {"Origin", "https://leetcode.com"},
+            {"Referer", referer.empty() ? "https://leetcode.com/" : referer}
+        };
+        if (auth == Auth::Session) {
+            // Read per request (an in-memory lookup) so a long-lived leetclid sees a new `leetcli login`
+            std::string session = get_session_cookie();
+            std::string csrf = get_csrf_token();
+            header["x-csrftoken"] = csrf;
+            header["Cookie"] = "LEETCODE_SESSION=" + session + "; csrftoken=" + csrf;
+        }
+        return header;
+    }
+
+    cpr::Response LeetCodeClient::graphql(const nlohmann::json& query, Auth auth, const std::string& referer) {
+        return post_json("https://leetcode.com/graphql", query.dump(), auth, referer);
+    }
+
+    cpr::Response LeetCodeClient::post_json(const std::string& url, const std::string& body, Auth auth,
+                                            const std::string& referer) {
+        // Checked before the headers so replay works without credentials
+        if (auto replayed = replay_exchange("POST", url, body)) return std::move(*replayed);
+        apply_rate_limit();
+        post_session_.SetUrl(cpr::Url{url});
+        post_session_.SetHeader(leetcode_headers(auth, referer));
+        post_session_.SetBody(cpr::Body{body});
+        cpr::Response r = post_session_.Post();
+        trace_http("POST", url, post_session_.GetCurlHolder()->handle, r.status_code);
+        record_exchange("POST", url, body, r);
+        return r;
+    }
+
+    cpr::Response LeetCodeClient::get(const std::string& url, Auth auth, const std::string& referer) {
+        if (auto replayed = replay_exchange("GET", url, "")) return std::move(*replayed);
+        apply_rate_limit();
+        get_session_.SetUrl(cpr::Url{url});
+        get_session_.SetHeader(leetcode_headers(auth, referer));
+        cpr::Response r = get_session_.Get();
+        trace_http("GET", url, get_session_.GetCurlHolder()->handle, r.status_code);
+        record_exchange("GET", url, "", r);
+        return r;
+    }
+
+    cpr::Response LeetCodeClient::post_external(const std::string& url, const std::string& body) {
+        if (auto replayed = replay_exchange("POST", url, body)) return std::move(*replayed);
+        apply_rate_limit();
+        post_session_.SetUrl(cpr::Url{url});
+        post_session_.SetHeader(cpr::Header{{"Content-Type", "application/json"}});
+        post_session_.SetBody(cpr::Body{body});
+        cpr::Response r = post_session_.Post();
+        trace_http("POST", url, post_session_.GetCurlHolder()->handle, r.status_code);
+        record_exchange("POST", url, body, r);
+        return r;
+    }
+
+    void set_transfer_rate_limit(std::int64_t bytes_per_sec) {
+        transfer_rate_limit.store(std::max<std::int64_t>(bytes_per_sec, 0), std::memory_order_relaxed);
+    }
+
+    LeetCodeClient& client() {
+        thread_local LeetCodeClient instance;
+        return instance;
+    }
+}
@@ -0,0 +1,683 @@
+#include "local_runner.h"
+#include "trace.h"
+#include "utils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <csignal>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace leetcli {
+
+    namespace {
+        // Everything the generated main() needs: LeetCode's node types plus a reader/writer
+        // for the judge's input/output notation ([1,2], "s", true, null, ...)
+        const char* kHarnessPrelude = R"HARNESS(#include <algorithm>
+#include <array>
+#include <bitset>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stack>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+using namespace std;
+
+struct ListNode {
+    int val;
+    ListNode *next;
+    ListNode() : val(0), next(nullptr) {}
+    ListNode(int x) : val(x), next(nullptr) {}
+    ListNode(int x, ListNode *next) : val(x), next(next) {}
+};
+
+struct TreeNode {
+    int val;
+    TreeNode *left;
+    TreeNode *right;
+    TreeNode() : val(0), left(nullptr), right(nullptr) {}
+    TreeNode(int x) : val(x), left(nullptr), right(nullptr) {}
+    TreeNode(int x, TreeNode *left, TreeNode *right) : val(x), left(left), right(right) {}
+};
+
+namespace lc_harness {
+    struct Input {
+        const string& s;
+        size_t i = 0;
+
+        void ws() { while (i < s.size() && isspace((unsigned char)s[i])) ++i; }
+        bool peek(char c) { ws(); return i < s.size() && s[i] == c; }
+        void expect(char c) {
+            ws();
+            if (i >= s.size() || s[i] != c) throw runtime_error(string("expected '") + c + "' at column " + to_string(i + 1));
+            ++i;
+        }
+        bool skip(char c) { if (!peek(c)) return false; ++i; return true; }
+        bool null() {
+            ws();
+            if (s.compare(i, 4, "null") != 0) return false;
+            i += 4;
+            return true;
+        }
+        string token() {
+            ws();
+            size_t b = i;
+            while (i < s.size() && (isalnum((unsigned char)s[i]) || s[i] == '-' || s[i] == '+' || s[i] == '.')) ++i;
+            if (b == i) throw runtime_error("unexpected input at column " + to_string(b + 1));
+            return s.substr(b, i - b);
+        }
+        string str() {
+            expect('"');
+            string out;
+            while (i < s.size() && s[i] != '"') {
+                char c = s[i++];
+                if (c != '\\' || i >= s.size()) { out += c; continue; }
+                char e = s[i++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': {
+                        unsigned cp = (unsigned)stoul(s.substr(i, 4), nullptr, 16);
+                        i += 4;
+                        if (cp < 0x80) out += (char)cp;
+                        else if (cp < 0x800) { out += (char)(0xC0 | (cp >> 6)); out += (char)(0x80 | (cp & 0x3F)); }
+                        else { out += (char)(0xE0 | (cp >> 12)); out += (char)(0x80 | ((cp >> 6) & 0x3F)); out += (char)(0x80 | (cp & 0x3F)); }
+                        break;
+                    }
+                    default: out += e;
+                }
+            }
+            expect('"');
+            return out;
+        }
+    };
+
+    template <class T> void read(Input& in, vector<T>& v);
+    template <class T> void write(string& out, const vector<T>& v);
+
+    void read(Input& in, int& v) { v = stoi(in.token()); }
+    void read(Input& in, long long& v) { v = stoll(in.token()); }
+    void read(Input& in, double& v) { v = stod(in.token()); }
+    void read(Input& in, bool& v) { v = in.token() == "true"; }
+    void read(Input& in, string& v) { v = in.str(); }
+    void read(Input& in, char& v) { string s = in.str(); v = s.empty() ? '\0' : s[0]; }
+
+    void read(Input& in, ListNode*& head) {
+        vector<int> vals;
+        read(in, vals);
+        ListNode dummy;
+        ListNode* tail = &dummy;
+        for (int x : vals) tail = tail->next = new ListNode(x);
+        head = dummy.next;
+    }
+
+    void read(Input& in, TreeNode*& root) {
+        vector<TreeNode*> nodes;
+        in.expect('[');
+        if (!in.peek(']')) {
+            do {
+                if (in.null()) { nodes.push_back(nullptr); continue; }
+                int x;
+                read(in, x);
+                nodes.push_back(new TreeNode(x));
+            } while (in.skip(','));
+        }
+        in.expect(']');
+        root = nodes.empty() ? nullptr : nodes[0];
+        size_t child = 1;
+        for (size_t k = 0; k < nodes.size() && child < nodes.size(); ++k) {
+            if (!nodes[k]) continue;
+            nodes[k]->left = nodes[child++];
+            if (child < nodes.size()) nodes[k]->right = nodes[child++];
+        }
+    }
+
+    template <class T> void read(Input& in, vector<T>& v) {
+        v.clear();
+        in.expect('[');
+        if (!in.peek(']')) {
+            do {
+                T x{};
+                read(in, x);
+                v.push_back(std::move(x));
+            } while (in.skip(','));
+        }
+        in.expect(']');
+    }
+
+    void write(string& out, int v) { out += to_string(v); }
+    void write(string& out, long long v) { out += to_string(v); }
+    void write(string& out, double v) { char buf[64]; snprintf(buf, sizeof buf, "%.5f", v); out += buf; }
+    void write(string& out, bool v) { out += v ? "true" : "false"; }
+    void write(string& out, const string& v) {
+        out += '"';
+        for (char c : v) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        out += '"';
+    }
+    void write(string& out, char c) { write(out, string(1, c)); }
+
+    void write(string& out, ListNode* head) {
+        vector<int> vals;
+        for (size_t n = 0; head && n < 1000000; head = head->next, ++n) vals.push_back(head->val);
+        write(out, vals);
+    }
+
+    void write(string& out, TreeNode* root) {
+        vector<string> parts;
+        queue<TreeNode*> q;
+        q.push(root);
+        while (!q.empty() && root) {
+            TreeNode* node = q.front();
+            q.pop();
+            if (!node) { parts.push_back("null"); continue; }
+            parts.push_back(to_string(node->val));
+            q.push(node->left);
+            q.push(node->right);
+        }
+        while (!parts.empty() && parts.back() == "null") parts.pop_back();
+        out += '[';
+        for (size_t k = 0; k < parts.size(); ++k) out += (k ? "," : "") + parts[k];
+        out += ']';
+    }
+
+    template <class T> void write(string& out, const vector<T>& v) {
+        out += '[';
+        for (size_t k = 0; k < v.size(); ++k) {
+            if (k) out += ',';
+            if constexpr (is_same<T, bool>::value) write(out, (bool)v[k]);
+            else write(out, v[k]);
+        }
+        out += ']';
+    }
+}
+
+)HARNESS";
+
+        // Exit codes the harness uses to tell the runner what happened
+        constexpr int kExitBadInput = 2;
+        constexpr int kExitOutOfMemory = 3;
+        // Largest file a case may write (its stdout, stderr and result)
+        constexpr rlim_t kMaxOutputBytes = rlim_t{64} * 1024 * 1024;
+
+        std::optional<std::string> cpp_type(std::string type) {
+            if (type.size() > 2 && type.compare(type.size() - 2, 2, "[]") == 0) {
+                auto inner = cpp_type(type.substr(0, type.size() - 2));
+                if (!inner) return std::nullopt;
+                return "vector<" + *inner + ">";
+            }
+            if (type.rfind("list<", 0) == 0 && type.back() == '>') {
+                auto inner = cpp_type(type.substr(5, type.size() - 6));
+                if (!inner) return std::nullopt;
+                return "vector<" + *inner + ">";
+            }
+            if (type == "integer") return "int";
+            if (type == "long") return "long long";
+            if (type == "double") return "double";
+            if (type == "boolean") return "bool";
+            if (type == "string") return "string";
+            if (type == "character") return "char";
+            if (type == "ListNode") return "ListNode*";
+            if (type == "TreeNode") return "TreeNode*";
+            return std::nullopt;
+        }
+
+        // Returns an empty string and sets error when the problem can't be run locally
+        std::string generate_harness(const nlohmann::json& meta, const std::string& code, std::string& error) {
+            if (meta.contains("classname") || meta.value("systemdesign", false) || !meta.contains("name")) {
+                error = "Local runs only support single-function problems (not design problems).";
+                return "";
+            }
+
+            std::ostringstream main_fn;
+            main_fn << "\n#line 1 \"leetcli_harness_main\"\n"
+                    << "int main() {\n"
+                    << "    string input((istreambuf_iterator<char>(cin)), istreambuf_iterator<char>());\n"
+                    << "    vector<string> lines;\n"
+                    << "    stringstream ss(input);\n"
+                    << "    for (string line; getline(ss, line);) {\n"
+                    << "        if (!line.empty() && line.back() == '\\r') line.pop_back();\n"
+                    << "        lines.push_back(line);\n"
+                    << "    }\n";
+
+            const auto params = meta.value("params", nlohmann::json::array());
+            main_fn << "    if (lines.size() < " << params.size() << ") {\n"
+                    << "        fprintf(stderr, \"expected " << params.size() << " input lines, got %zu\\n\", lines.size());\n"
+                    << "        return " << kExitBadInput << ";\n"
+                    << "    }\n";
+
+            std::string args;
+            for (size_t i = 0; i < params.size(); ++i) {
+                std::string type = params[i].value("type", "");
+                auto cpp = cpp_type(type);
+                if (!cpp) {
+                    error = "Unsupported parameter type for local runs: " + type;
+                    return "";
+                }
+                main_fn << "    " << *cpp << " p" << i << "{};\n";
+                args += (i ? ", p" : "p") + std::to_string(i);
+            }
+
+            main_fn << "    try {\n";
+            for (size_t i = 0; i < params.size(); ++i) {
+                main_fn << "        { lc_harness::Input in{lines[" << i << "]}; lc_harness::read(in, p" << i << "); }\n";
+            }
+            main_fn << "    } catch (const exception& e) {\n"
+                    << "        fprintf(stderr, \"could not parse input: %s\\n\", e.what());\n"
+                    << "        return " << kExitBadInput << ";\n"
+                    << "    }\n"
+                    << "    string out;\n"
+                    << "    try {\n"
+                    << "        Solution solution;\n";
+
+            std::string return_type = meta.value("return", nlohmann::json::object()).value("type", "void");
+            std::string name = meta["name"];
+            if (return_type == "void") {
+                // In-place problems: the judge prints the mutated argument instead
+                int index = meta.value("output", nlohmann::json::object()).value("paramindex", 0);
+                if (index < 0 || static_cast<size_t>(index) >= params.size()) {
+                    error = "Unsupported output for local runs.";
+                    return "";
+                }
+                main_fn << "        solution." << name << "(" << args << ");\n"
+                        << "        lc_harness::write(out, p" << index << ");\n";
+            } else {
+                if (!cpp_type(return_type)) {
+                    error = "Unsupported return type for local runs: " + return_type;
+                    return "";
+                }
+                main_fn << "        auto result = solution." << name << "(" << args << ");\n"
+                        << "        lc_harness::write(out, result);\n";
+            }
+            main_fn << "    } catch (const bad_alloc&) {\n"
+                    << "        return " << kExitOutOfMemory << ";\n"
+                    << "    }\n"
+                    << "    cout.flush();\n"
+                    << "    for (size_t off = 0; off < out.size();) {\n"
+                    << "        ssize_t n = ::write(3, out.data() + off, out.size() - off);\n"
+                    << "        if (n <= 0) break;\n"
+                    << "        off += static_cast<size_t>(n);\n"
+                    << "    }\n"
+                    << "    return 0;\n"
+                    << "}\n";
+
+            // #line keeps compiler errors pointing at solution.cpp
+            return "#line 1 \"solution.cpp\"\n" + code + "\n" + main_fn.str();
+        }
+
+        std::string read_text(const std::filesystem::path& path, size_t max_bytes = std::string::npos) {
+            std::ifstream in(path, std::ios::binary);
+            std::ostringstream ss;
+            ss << in.rdbuf();
+            std::string text = ss.str();
+            if (text.size() > max_bytes) text = text.substr(0, max_bytes) + "\n... (truncated)";
+            return text;
+        }
+
+        std::string trim_trailing_newlines(std::string s) {
+            while (!s.empty() && (s.back() == '\n' || s.back() == '\r')) s.pop_back();
+            return s;
+        }
+
+        std::string quote(const std::filesystem::path& path) {
+            std::string out = "'";
+            for (char c : path.string()) {
+                if (c == '\'') out += "'\\''";
+                else out += c;
+            }
+            return out + "'";
+        }
+
+        // Drops all but the newest builds so the cache doesn't grow forever
+        void prune_builds(const std::filesystem::path& root, size_t keep) {
+            std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> builds;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(root, ec)) {
+                if (entry.is_directory() && entry.path().filename().string().rfind("prelude-", 0) != 0) builds.emplace_back(std::filesystem::last_write_time(entry.path(), ec), entry.path());
+            }
+            if (builds.size() <= keep) return;
+            std::sort(builds.begin(), builds.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+            for (size_t i = keep; i < builds.size(); ++i) std::filesystem::remove_all(builds[i].second, ec);
+        }
+
+        struct CaseOutcome {
+            enum class Kind { Ok, TimeLimit, MemoryLimit, RuntimeError } kind = Kind::Ok;
+            std::string output;
+            std::string std_output;
+            std::string message;
+            long cpu_ms = 0;
+            long max_rss_kb = 0;
+        };
+    }
+
+#ifdef _WIN32
+    RunReport run_local(const std::string&, const std::string&, const std::vector<std::string>&, const LocalRunOptions&) {
+        RunReport report;
+        report.status_msg = "Local runs are not supported on Windows";
+        return report;
+    }
+#else
+    namespace {
+        // leetclid compiles on several threads of one process, so a pid alone doesn't make a scratch name unique
+        std::string scratch_suffix() {
+            return std::to_string(getpid()) + "-" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        }
+
+        // The prelude (all the standard headers) dominates compile time, so it is precompiled once per
+        // compiler. If the compiler can't build or use the PCH, -include falls back to the plain header.
+        std::filesystem::path ensure_prelude(const std::filesystem::path& root, const std::string& compiler,
+                                             const std::string& flags) {
+            std::filesystem::path dir = root / ("prelude-" + hash_hex(compiler + "\n" + flags + "\n" + kHarnessPrelude));
+            std::filesystem::path header = dir / "prelude.h";
+            if (std::filesystem::exists(header)) return header;
+
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+            std::filesystem::path pch = dir / ("prelude.h.gch.tmp" + scratch_suffix());
+            std::string command = compiler + " " + flags + " -x c++-header -o " + quote(pch) + " " +
+                                  quote(dir / "prelude.src.h") + " > /dev/null 2>&1";
+            write_file_atomic(dir / "prelude.src.h", kHarnessPrelude);
+            if (std::system(command.c_str()) == 0) std::filesystem::rename(pch, dir / "prelude.h.gch", ec);
+            std::filesystem::remove(pch, ec);
+            // Written last: its presence marks the prelude as ready
+            write_file_atomic(header, kHarnessPrelude);
+            return header;
+        }
+
+        int compile_harness(const std::string& source, std::filesystem::path& binary, std::string& error) {
+            const char* env_cxx = std::getenv("CXX");
+            std::string compiler = env_cxx && *env_cxx ? env_cxx : "c++";
+            std::string flags = "-std=c++17 -O2";
+            std::string key = hash_hex(compiler + "\n" + flags + "\n" + kHarnessPrelude + source);
+
+            std::filesystem::path root = get_home() / ".leetcli/cache/local";
+            std::filesystem::path prelude = ensure_prelude(root, compiler, flags);
+            std::filesystem::path dir = root / key;
+            binary = dir / "solution";
+            if (std::filesystem::exists(binary)) return 0;
+
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+            std::filesystem::path source_path = dir / "harness.cpp";
+            std::filesystem::path log_path = dir / ("compile.log." + scratch_suffix());
+            std::filesystem::path tmp_binary = dir / ("solution.tmp" + scratch_suffix());
+            if (!write_file_atomic(source_path, source)) {
+                error = "Could not write " + source_path.string();
+                return 1;
+            }
+
+            std::string command = compiler + " " + flags + " -include " + quote(prelude) + " -o " + quote(tmp_binary) + " " + quote(source_path) +
+                                  " > " + quote(log_path) + " 2>&1";
+            if (std::system(command.c_str()) != 0) {
+                error = read_text(log_path, 8000);
+                std::filesystem::remove_all(dir, ec);
+                return 1;
+            }
+            std::filesystem::rename(tmp_binary, binary, ec);
+            std::filesystem::remove(log_path, ec);
+            prune_builds(root, 32);
+            return 0;
+        }
+
+        struct Child {
+            size_t index;
+            pid_t pid;
+            std::chrono::steady_clock::time_point started;
+            bool killed = false;
+        };
+
+        pid_t spawn_case(const std::filesystem::path& binary, const std::filesystem::path& work, size_t index,
+                         const LocalRunOptions& options) {
+            // Build every path before fork(): only async-signal-safe calls are allowed in the child
+            std::string base = (work / std::to_string(index)).string();
+            std::string in_path = base + ".in", out_path = base + ".out", err_path = base + ".err", res_path = base + ".res";
+            std::string bin = binary.string();
+            rlim_t cpu_seconds = static_cast<rlim_t>((options.cpu_limit.count() + 999) / 1000);
+            rlim_t memory = static_cast<rlim_t>(options.memory_limit_mb) * 1024 * 1024;
+
+            pid_t pid = fork();
+            if (pid != 0) return pid;
+
+            int in = open(in_path.c_str(), O_RDONLY);
+            int out = open(out_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            int err = open(err_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            int res = open(res_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (in < 0 || out < 0 || err < 0 || res < 0) _exit(127);
+            dup2(in, 0);
+            dup2(out, 1);
+            dup2(err, 2);
+            dup2(res, 3);
+
+            struct rlimit cpu{cpu_seconds, cpu_seconds + 1};
+            setrlimit(RLIMIT_CPU, &cpu);
+            struct rlimit as{memory, memory};
+            setrlimit(RLIMIT_AS, &as);
+            struct rlimit core{0, 0};
+            setrlimit(RLIMIT_CORE, &core);
+            // No forking, and no filling the disk; this is a limit, not a sandbox
+            struct rlimit procs{0, 0};
+            setrlimit(RLIMIT_NPROC, &procs);
+            struct rlimit file_size{kMaxOutputBytes, kMaxOutputBytes};
+            setrlimit(RLIMIT_FSIZE, &file_size);
+
+            execl(bin.c_str(), bin.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+
+        CaseOutcome collect_case(const std::filesystem::path& work, size_t index, int status, const struct rusage& usage,
+                                 bool killed, const LocalRunOptions& options) {
+            std::string base = (work / std::to_string(index)).string();
+            CaseOutcome outcome;
+            outcome.cpu_ms = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000L +
+                             (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000L;
+#ifdef __APPLE__
+            outcome.max_rss_kb = usage.ru_maxrss / 1024;
+#else
+            outcome.max_rss_kb = usage.ru_maxrss;
+#endif
+            outcome.std_output = trim_trailing_newlines(read_text(base + ".out", 4000));
+            std::string stderr_text = trim_trailing_newlines(read_text(base + ".err", 4000));
+
+            using Kind = CaseOutcome::Kind;
+            if (killed || (WIFSIGNALED(status) && (WTERMSIG(status) == SIGXCPU || WTERMSIG(status) == SIGKILL)) ||
+                outcome.cpu_ms > options.cpu_limit.count()) {
+                outcome.kind = Kind::TimeLimit;
+                outcome.message = "Time Limit Exceeded";
+            } else if (WIFEXITED(status) && WEXITSTATUS(status) == kExitOutOfMemory) {
+                outcome.kind = Kind::MemoryLimit;
+                outcome.message = "Memory Limit Exceeded";
+            } else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGXFSZ) {
+                outcome.kind = Kind::RuntimeError;
+                outcome.message = "Output Limit Exceeded";
+            } else if (WIFSIGNALED(status)) {
+                outcome.kind = Kind::RuntimeError;
+                outcome.message = std::string(strsignal(WTERMSIG(status)));
+                if (!stderr_text.empty()) outcome.message += "\n" + stderr_text;
+            } else if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+                outcome.kind = Kind::RuntimeError;
+                outcome.message = WEXITSTATUS(status) == kExitBadInput ? "Bad testcase: " + stderr_text
+                                : "Exited with code " + std::to_string(WEXITSTATUS(status)) +
+                                  (stderr_text.empty() ? "" : "\n" + stderr_text);
+            } else {
+                outcome.output = read_text(base + ".res");
+            }
+            return outcome;
+        }
+    }
+
+    RunReport run_local(const std::string& folder_path, const std::string& solution_path,
+                        const std::vector<std::string>& cases, const LocalRunOptions& options) {
+        const auto start = std::chrono::steady_clock::now();
+        RunReport report;
+        report.lang = "C++ (local)";
+
+        std::ifstream problem_in(std::filesystem::path(folder_path) / "problem.json");
+        nlohmann::json question = problem_in ? nlohmann::json::parse(problem_in, nullptr, false) : nlohmann::json();
+        nlohmann::json meta;
+        if (question.is_object() && question.contains("metaData") && question["metaData"].is_string()) {
+            meta = nlohmann::json::parse(question["metaData"].get<std::string>(), nullptr, false);
+        }
+        if (!meta.is_object()) {
+            report.status_msg = "No problem metadata; run 'leetcli fetch' again to download problem.json";
+            return report;
+        }
+
+        std::string error;
+        std::string harness = generate_harness(meta, read_text(solution_path), error);
+        if (harness.empty()) {
+            report.status_msg = error;
+            return report;
+        }
+
+        std::filesystem::path binary;
+        int compiled;
+        {
+            TraceSpan span("local compile", "local");
+            compiled = compile_harness(harness, binary, error);
+        }
+        if (compiled != 0) {
+            report.status_msg = "Compile Error";
+            report.compile_error = error;
+            return report;
+        }
+
+        // mkdtemp: a fresh 0700 directory, so nobody else can pre-create it or plant a symlink in /tmp
+        std::error_code ec;
+        std::string work_template = (std::filesystem::temp_directory_path(ec) / "leetcli-run-XXXXXX").string();
+        if (!mkdtemp(work_template.data())) {
+            report.status_msg = std::string("Could not create a work directory: ") + std::strerror(errno);
+            return report;
+        }
+        std::filesystem::path work = work_template;
+        for (size_t i = 0; i < cases.size(); ++i) {
+            std::ofstream(work / (std::to_string(i) + ".in"), std::ios::binary) << cases[i] << "\n";
+        }
+
+        // Wall-clock cap catches solutions that sleep or block instead of burning CPU
+        const auto wall_limit = options.cpu_limit * 3 + std::chrono::seconds(1);
+        unsigned jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+        std::vector<CaseOutcome> outcomes(cases.size());
+        std::vector<Child> running;
+        size_t next = 0;
+
+        bool cancelled = false;
+        TraceSpan cases_span("local cases", "local");
+        while (next < cases.size() || !running.empty()) {
+            if (!cancelled && options.cancel && *options.cancel) {
+                cancelled = true;
+                next = cases.size();
+                for (auto& child : running) {
+                    kill(child.pid, SIGKILL);
+                    child.killed = true;
+                }
+            }
+            while (running.size() < jobs && next < cases.size()) {
+                pid_t pid = spawn_case(binary, work, next, options);
+                if (pid < 0) {
+                    outcomes[next].kind = CaseOutcome::Kind::RuntimeError;
+                    outcomes[next].message = std::string("fork failed: ") + std::strerror(errno);
+                } else {
+                    running.push_back({next, pid, std::chrono::steady_clock::now()});
+                }
+                ++next;
+            }
+
+            bool reaped = false;
+            for (auto it = running.begin(); it != running.end();) {
+                int status = 0;
+                struct rusage usage{};
+                if (wait4(it->pid, &status, WNOHANG, &usage) == it->pid) {
+                    outcomes[it->index] = collect_case(work, it->index, status, usage, it->killed, options);
+                    it = running.erase(it);
+                    reaped = true;
+                    continue;
+                }
+                if (!it->killed && std::chrono::steady_clock::now() - it->started > wall_limit) {
+                    kill(it->pid, SIGKILL);
+                    it->killed = true;
+                }
+                ++it;
+            }
+            if (!reaped && !running.empty()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::filesystem::remove_all(work, ec);
+        if (cancelled) {
+            report.status_msg = "Cancelled";
+            report.waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            return report;
+        }
+
+        long max_cpu = 0, max_rss = 0;
+        for (size_t i = 0; i < cases.size(); ++i) {
+            const CaseOutcome& outcome = outcomes[i];
+            max_cpu = std::max(max_cpu, outcome.cpu_ms);
+            max_rss = std::max(max_rss, outcome.max_rss_kb);
+
+            // Like the judge, the first failing case decides the verdict
+            if (outcome.kind != CaseOutcome::Kind::Ok) {
+                report.status_msg = outcome.kind == CaseOutcome::Kind::TimeLimit ? "Time Limit Exceeded"
+                                  : outcome.kind == CaseOutcome::Kind::MemoryLimit ? "Memory Limit Exceeded"
+                                  : "Runtime Error";
+                report.runtime_error = "Case " + std::to_string(i + 1) + ": " + outcome.message + "\nLast input:\n" + cases[i];
+                if (!outcome.std_output.empty()) report.runtime_error += "\nStdout:\n" + outcome.std_output;
+                report.waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+                return report;
+            }
+
+            TestCaseResult row;
+            row.input = cases[i];
+            row.output = outcome.output;
+            row.std_output = outcome.std_output;
+            row.judged = false; // no expected answers locally
+            report.cases.push_back(row);
+        }
+
+        char memory[32];
+        std::snprintf(memory, sizeof(memory), "%.1f MB", max_rss / 1024.0);
+        report.ok = true;
+        report.status_msg = "Finished";
+        report.runtime = std::to_string(max_cpu) + " ms";
+        report.memory = memory;
+        report.waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        return report;
+    }
+#endif
+}
@@ -1,209 +1,71 @@
-#include "leetcode_api.h"
+#include "commands.h"
+#include "daemon.h"
+#include "trace.h"
+#include "transport.h"
 #include "utils.h"
+#include <cstdlib>
+#include <exception>
 #include <iostream>
 
 int main(int argc, char **argv) {
     std::vector<std::string> args(argv + 1, argv + argc);
-    if (argc < 2) {
-        std::cout << "Usage:\n"
-                << "  leetcli init\n"
-                << "  leetcli fetch <slug>\n";
-        return 1;
-    }
-
-    std::string command = argv[1];
-
-    if (command == "init") {
-        leetcli::init_problems_folder();
-        return 0;
-    }
-
-    if (command == "fetch") {
-
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli fetch <slug> [--lang=cpp|python|java]\n";
-            return 1;
-        }
-
-        std::string slug = argv[2];
-
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
-        }
-
-        std::string lang_override;
-
-        // Check for --lang=xxx
-        for (int i = 3; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg.rfind("--lang=", 0) == 0) {
-                lang_override = arg.substr(7); // everything after --lang=
-            }
-        }
-
-        std::string problem = leetcli::fetch_problem(slug, lang_override); // pass override to function
-        std::cout << problem << "\n";
-        return 0;
-    }
-
-    if (command == "solve") {
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli solve <slug> [--lang=cpp|python|java]\n";
-            return 1;
-        }
-        std::string lang_override;
-
-        for (int i = 3; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg.rfind("--lang=", 0) == 0) {
-                lang_override = arg.substr(7);
-            }
-        }
-        std::string slug = argv[2];
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
-        }
-        leetcli::solve_problem(slug, lang_override);
-        return 0;
-    }
-    if (command == "hints") {
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli hints <slug>\n";
-            return 1;
-        }
-
-        std::string slug = argv[2];
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
-        }
-        leetcli::fetch_problem_hints(slug);
-        return 0;
-    }
-    if (command == "topics") {
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli topics <slug>\n";
-            return 1;
-        }
 
-        std::string slug = argv[2];
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
+    // --trace[=file.json] works with every command
+    for (auto it = args.begin(); it != args.end();) {
+        if (*it == "--trace" || it->rfind("--trace=", 0) == 0) {
+            leetcli::enable_trace(it->size() > 8 ? it->substr(8) : "");
+            it = args.erase(it);
+        } else {
+            ++it;
         }
-        leetcli::fetch_problem_topics(slug);
-        return 0;
-    }
-    if (command == "list") {
-        leetcli::list_fetched_problems();
-        return 0;
     }
 
-    if (command == "login") {
-        leetcli::set_session_cookie();
-        return 0;
-    }
-    if (command == "submit") {
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli submit <slug> [--lang=cpp|python|java]\n";
-            return 1;
-        }
-        std::string slug = argv[2];
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
-        }
-        std::string lang_override;
-
-        for (int i = 3; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg.rfind("--lang=", 0) == 0) {
-                lang_override = arg.substr(7);
+    // --record[=file] / --replay[=file] / --passthrough pick the HTTP transport; see transport.h
+    leetcli::TransportOptions transport;
+    transport.cassette_path = (leetcli::get_home() / ".leetcli/cassette.json").string();
+    for (auto it = args.begin(); it != args.end();) {
+        const std::string& arg = *it;
+        if (arg == "--passthrough") {
+            transport.mode = leetcli::TransportMode::Passthrough;
+        } else if (arg == "--record" || arg.rfind("--record=", 0) == 0) {
+            transport.mode = leetcli::TransportMode::Record;
+            if (arg.size() > 9) transport.cassette_path = arg.substr(9);
+        } else if (arg == "--replay" || arg.rfind("--replay=", 0) == 0) {
+            transport.mode = leetcli::TransportMode::Replay;
+            if (arg.size() > 9) transport.cassette_path = arg.substr(9);
+        } else if (arg.rfind("--replay-latency=", 0) == 0) {
+            std::string value = arg.substr(17);
+            if (value == "recorded") {
+                transport.latency.reset();
+            } else {
+                try {
+                    transport.latency = std::chrono::milliseconds(std::stoll(value));
+                } catch (const std::exception&) {
+                    std::cerr << "❌ --replay-latency expects milliseconds or \"recorded\".\n";
+                    return 1;
+                }
             }
+        } else {
+            ++it;
+            continue;
         }
-
-        leetcli::submit_solution(slug, lang_override);
-        return 0;
+        it = args.erase(it);
     }
-    if (command == "run") {
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli run <slug> [--lang=cpp|python|java]\n";
-            return 1;
-        }
-        std::string slug = argv[2];
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
-        }
-        std::string lang_override;
+    if (transport.mode != leetcli::TransportMode::Passthrough) leetcli::configure_transport(transport);
 
-        for (int i = 3; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg.rfind("--lang=", 0) == 0) {
-                lang_override = arg.substr(7);
-            }
-        }
-        leetcli::run_tests(slug, lang_override);
-        return 0;
-    } if (command == "config") {
-        leetcli::handle_config_command(args);
-        return 0;
+    // A running leetclid already has config, metadata and connections warm; traces and cassettes are
+    // taken in-process
+    if (!leetcli::trace_enabled() && transport.mode == leetcli::TransportMode::Passthrough && leetcli::runs_in_daemon(args) && !std::getenv("LEETCLI_NO_DAEMON")) {
+        if (auto code = leetcli::forward_to_daemon(args)) return *code;
     }
-    if (command == "runtime") {
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli runtime <slug> [--lang=cpp|python|java]\n";
-            return 1;
-        }
-        std::string slug = argv[2];
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
-        }
-        std::string lang_override;
-
-        for (int i = 3; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg.rfind("--lang=", 0) == 0) {
-                lang_override = arg.substr(7);
-            }
-        }
-        leetcli::analyze_runtime(slug, lang_override);
-        return 0;
-    }
-    if (command == "hint") {
-        if (argc < 3) {
-            std::cerr << "Usage: leetcli hint <slug> [--lang=cpp|python|java]\n";
-            return 1;
-        }
-        std::string slug = argv[2];
-        if (slug == "daily") {
-            slug = leetcli::get_daily_question_slug();
-        }
-        std::string lang_override;
 
-        for (int i = 3; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg.rfind("--lang=", 0) == 0) {
-                lang_override = arg.substr(7);
-            }
-        }
-        leetcli::give_hint(slug, lang_override);
-        return 0;
-    }
-    if (command == "help") {
-        std::cout << "leetcli - LeetCode CLI Tool\n\n"
-                  << "Usage:\n"
-                  << "  leetcli init                        Initialize the problems directory in your current directory\n"
-                  << "  leetcli fetch <slug> [--lang=...]   Fetch a problem by slug or use 'daily' for the daily question\n"
-                  << "  leetcli solve <slug> [--lang=...]   Open the solution file in your default editor\n"
-                  << "  leetcli list                        List all fetched problems\n"
-                  << "  leetcli login                       Set your LEETCODE_SESSION and CSRF token\n"
-                  << "  leetcli run <slug>  [--lang=...]    Run your solution against LeetCode testcases\n"
-                  << "  leetcli submit <slug> [--lang=...]  Submit your solution to LeetCode\n"
-                  << "  leetcli runtime <slug> [--lang=...] Analyze time/space complexity using Gemini\n"
-                  << "  leetcli hint <slug> [--lang=...]    Ask Gemini for a helpful hint based on your solution progress\n"
-                  << "  leetcli hints <slug>                Gets the hints for the given problem in leetcode\n"
-                  << "  leetcli topics <slug>               Gets the topics for the given problem in leetcode\n"
-                  << "  leetcli config set-gemini-key <key> Set your Gemini API key\n"
-                  << "  leetcli help                        Show this help message\n";
-        return 0;
+    int code;
+    try {
+        code = leetcli::run_command(args);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        code = 1;
     }
-
-    std::cerr << "Unknown command: " << command << "\n";
-    return 1;
+    leetcli::finish_trace();
+    return code;
 }
@@ -0,0 +1,335 @@
+#include "manifest.h"
+#include "utils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace leetcli {
+
+    namespace {
+        std::mutex manifest_mutex;
+
+        struct Manifest {
+            int64_t root_mtime = 0;
+            std::map<std::string, ManifestEntry> entries; // keyed by folder name
+        };
+
+
+        std::filesystem::path manifest_path() {
+            return get_workspace_state_dir() / "manifest.json";
+        }
+
+        int64_t mtime_of(const std::filesystem::path& path) {
+            std::error_code ec;
+            auto t = std::filesystem::last_write_time(path, ec);
+            return ec ? 0 : static_cast<int64_t>(t.time_since_epoch().count());
+        }
+
+        int64_t now_seconds() {
+            return static_cast<int64_t>(std::time(nullptr));
+        }
+
+        ManifestEntry entry_from_json(const std::string& folder, const nlohmann::json& j) {
+            ManifestEntry e;
+            e.folder = folder;
+            e.slug = j.value("slug", "");
+            e.id = j.value("id", "");
+            e.title = j.value("title", "");
+            e.difficulty = j.value("difficulty", "");
+            e.languages = j.value("languages", std::vector<std::string>{});
+            e.folder_mtime = j.value("folder_mtime", int64_t{0});
+            e.last_run_status = j.value("last_run_status", "");
+            e.last_run_at = j.value("last_run_at", int64_t{0});
+            e.last_submit_status = j.value("last_submit_status", "");
+            e.last_submit_at = j.value("last_submit_at", int64_t{0});
+            e.accepted = j.value("accepted", false);
+            return e;
+        }
+
+        nlohmann::json entry_to_json(const ManifestEntry& e) {
+            return {
+                {"slug", e.slug},
+                {"id", e.id},
+                {"title", e.title},
+                {"difficulty", e.difficulty},
+                {"languages", e.languages},
+                {"folder_mtime", e.folder_mtime},
+                {"last_run_status", e.last_run_status},
+                {"last_run_at", e.last_run_at},
+                {"last_submit_status", e.last_submit_status},
+                {"last_submit_at", e.last_submit_at},
+                {"accepted", e.accepted}
+            };
+        }
+
+        Manifest read_manifest() {
+            Manifest m;
+            std::ifstream in(manifest_path());
+            if (!in) return m;
+            nlohmann::json j = nlohmann::json::parse(in, nullptr, false);
+            if (j.is_discarded() || !j.is_object() || j.value("version", 0) != 1) return m;
+
+            m.root_mtime = j.value("root_mtime", int64_t{0});
+            const nlohmann::json problems = j.value("problems", nlohmann::json::object());
+            for (const auto& [folder, value] : problems.items()) {
+                if (value.is_object()) m.entries[folder] = entry_from_json(folder, value);
+            }
+            return m;
+        }
+
+        void write_manifest(const Manifest& m) {
+            nlohmann::json problems = nlohmann::json::object();
+            for (const auto& [folder, e] : m.entries) problems[folder] = entry_to_json(e);
+            nlohmann::json j = {{"version", 1}, {"root_mtime", m.root_mtime}, {"problems", problems}};
+            if (!write_file_atomic(manifest_path(), j.dump(1))) {
+                std::cerr << "Failed to update manifest: " << manifest_path() << "\n";
+            }
+        }
+
+        // Fills in everything that comes from the files on disk; run/submit history is left alone
+        void scan_folder(const std::filesystem::path& dir, ManifestEntry& e) {
+            e.folder = dir.filename().string();
+            e.folder_mtime = mtime_of(dir);
+
+            e.languages.clear();
+            std::error_code ec;
+            for (const auto& file : std::filesystem::directory_iterator(dir, ec)) {
+                if (file.path().stem() != "solution") continue;
+                if (const Language* lang = language_for_extension(file.path().extension().string())) {
+                    e.languages.push_back(lang->name);
+                }
+            }
+            std::sort(e.languages.begin(), e.languages.end());
+
+            std::ifstream in(dir / "problem.json");
+            nlohmann::json question = in ? nlohmann::json::parse(in, nullptr, false) : nlohmann::json();
+            if (question.is_object()) {
+                e.slug = question.value("titleSlug", e.slug);
+                e.id = question.value("questionFrontendId", question.value("questionId", e.id));
+                e.title = question.value("title", e.title);
+                e.difficulty = question.value("difficulty", e.difficulty);
+            } else if (e.title.empty()) {
+                // Folders from before problem.json existed: "<id>. <title>"
+                size_t dot = e.folder.find(". ");
+                e.id = dot == std::string::npos ? "" : e.folder.substr(0, dot);
+                e.title = dot == std::string::npos ? e.folder : e.folder.substr(dot + 2);
+            }
+        }
+
+        // Returns true when anything changed. The root mtime alone only moves when folders are added,
+        // removed or renamed, so every folder's own mtime is checked too (one stat each).
+        bool refresh(Manifest& m, bool force_scan) {
+            std::string problems_dir = get_problems_dir();
+            int64_t root = mtime_of(problems_dir);
+            bool changed = root != m.root_mtime;
+
+            std::set<std::string> seen;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(problems_dir, ec)) {
+                std::string folder = entry.path().filename().string();
+                if (!entry.is_directory() || folder[0] == '.') continue;
+                seen.insert(folder);
+
+                auto it = m.entries.find(folder);
+                if (!force_scan && it != m.entries.end() && it->second.folder_mtime == mtime_of(entry.path())) continue;
+                scan_folder(entry.path(), m.entries[folder]);
+                changed = true;
+            }
+            for (auto it = m.entries.begin(); it != m.entries.end();) {
+                if (seen.count(it->first)) {
+                    ++it;
+                } else {
+                    it = m.entries.erase(it);
+                    changed = true;
+                }
+            }
+            m.root_mtime = root;
+            return changed;
+        }
+
+        void record_status(const std::string& folder_path, bool submit, const std::string& status) {
+            std::lock_guard<std::mutex> lock(manifest_mutex);
+            Manifest m = read_manifest();
+            std::filesystem::path dir(folder_path);
+            auto it = m.entries.find(dir.filename().string());
+            if (it == m.entries.end()) {
+                it = m.entries.emplace(dir.filename().string(), ManifestEntry{}).first;
+                scan_folder(dir, it->second);
+            }
+
+            ManifestEntry& e = it->second;
+            if (submit) {
+                e.last_submit_status = status;
+                e.last_submit_at = now_seconds();
+                e.accepted = e.accepted || status == "Accepted";
+            } else {
+                e.last_run_status = status;
+                e.last_run_at = now_seconds();
+            }
+            write_manifest(m);
+        }
+
+        int difficulty_rank(const std::string& difficulty) {
+            if (difficulty == "Easy") return 0;
+            if (difficulty == "Medium") return 1;
+            if (difficulty == "Hard") return 2;
+            return 3;
+        }
+
+        long long numeric_id(const std::string& id) {
+            try {
+                return std::stoll(id);
+            } catch (const std::exception&) {
+                return 0;
+            }
+        }
+
+        std::string state_of(const ManifestEntry& e) {
+            if (e.accepted) return "solved";
+            if (e.last_run_at || e.last_submit_at) return "attempted";
+            return "todo";
+        }
+
+        std::string format_date(int64_t seconds) {
+            std::time_t t = static_cast<std::time_t>(seconds);
+            std::tm tm{};
+#ifdef _WIN32
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            char buf[16];
+            std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tm);
+            return buf;
+        }
+
+        std::string join(const std::vector<std::string>& parts) {
+            std::string out;
+            for (const auto& p : parts) out += (out.empty() ? "" : ",") + p;
+            return out;
+        }
+    }
+
+    void update_manifest(const std::vector<std::string>& folder_paths) {
+        if (folder_paths.empty()) return;
+        std::lock_guard<std::mutex> lock(manifest_mutex);
+        Manifest m = read_manifest();
+        for (const auto& path : folder_paths) {
+            std::filesystem::path dir(path);
+            scan_folder(dir, m.entries[dir.filename().string()]);
+        }
+        write_manifest(m);
+    }
+
+    void record_run_status(const std::string& folder_path, const std::string& status) {
+        record_status(folder_path, false, status);
+    }
+
+    void record_submit_status(const std::string& folder_path, const std::string& status) {
+        record_status(folder_path, true, status);
+    }
+
+    std::vector<ManifestEntry> load_manifest(bool force_scan) {
+        std::lock_guard<std::mutex> lock(manifest_mutex);
+        Manifest m = read_manifest();
+        if (refresh(m, force_scan)) write_manifest(m);
+
+        std::vector<ManifestEntry> entries;
+        entries.reserve(m.entries.size());
+        for (auto& [folder, e] : m.entries) entries.push_back(std::move(e));
+        return entries;
+    }
+
+    void handle_list_command(const std::vector<std::string>& args) {
+        std::string sort_key = "id";
+        std::string status_filter, lang_filter, difficulty_filter;
+        bool force_scan = false;
+        for (size_t i = 1; i < args.size(); ++i) {
+            const std::string& a = args[i];
+            if (a.rfind("--sort=", 0) == 0) {
+                sort_key = a.substr(7);
+            } else if (a.rfind("--status=", 0) == 0) {
+                status_filter = a.substr(9);
+            } else if (a.rfind("--lang=", 0) == 0) {
+                lang_filter = a.substr(7);
+            } else if (a.rfind("--difficulty=", 0) == 0) {
+                difficulty_filter = a.substr(13);
+            } else if (a == "--refresh") {
+                force_scan = true;
+            } else {
+                std::cerr << "Unknown option: " << a << "\n";
+                std::cerr << "Usage: leetcli list [--sort=id|title|difficulty|recent] [--status=solved|attempted|todo]"
+                             " [--lang=...] [--difficulty=...] [--refresh]\n";
+                return;
+            }
+        }
+        if (!difficulty_filter.empty()) {
+            difficulty_filter[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(difficulty_filter[0])));
+        }
+
+        std::string problems_dir = get_problems_dir();
+        if (!std::filesystem::exists(problems_dir)) {
+            std::cerr << "Problems directory not found: " << problems_dir << "\n";
+            return;
+        }
+
+        std::vector<ManifestEntry> entries = load_manifest(force_scan);
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const ManifestEntry& e) {
+            if (!status_filter.empty() && state_of(e) != status_filter) return true;
+            if (!difficulty_filter.empty() && e.difficulty != difficulty_filter) return true;
+            if (!lang_filter.empty() && std::find(e.languages.begin(), e.languages.end(), lang_filter) == e.languages.end()) return true;
+            return false;
+        }), entries.end());
+
+        auto by_id = [](const ManifestEntry& a, const ManifestEntry& b) {
+            long long x = numeric_id(a.id), y = numeric_id(b.id);
+            return x != y ? x < y : a.folder < b.folder;
+        };
+        if (sort_key == "title") {
+            std::sort(entries.begin(), entries.end(), [](const ManifestEntry& a, const ManifestEntry& b) { return a.title < b.title; });
+        } else if (sort_key == "difficulty") {
+            std::sort(entries.begin(), entries.end(), [&](const ManifestEntry& a, const ManifestEntry& b) {
+                int x = difficulty_rank(a.difficulty), y = difficulty_rank(b.difficulty);
+                return x != y ? x < y : by_id(a, b);
+            });
+        } else if (sort_key == "recent") {
+            std::sort(entries.begin(), entries.end(), [&](const ManifestEntry& a, const ManifestEntry& b) {
+                int64_t x = std::max(a.last_run_at, a.last_submit_at), y = std::max(b.last_run_at, b.last_submit_at);
+                return x != y ? x > y : by_id(a, b);
+            });
+        } else {
+            std::sort(entries.begin(), entries.end(), by_id);
+        }
+
+        size_t title_width = 10;
+        for (const auto& e : entries) title_width = std::max(title_width, std::min<size_t>(e.id.size() + 2 + e.title.size(), 50));
+
+        std::ostringstream out;
+        out << "Fetched problems:\n";
+        for (const auto& e : entries) {
+            std::string state = state_of(e);
+            std::string icon = state == "solved" ? "[✅]" : state == "attempted" ? "[❌]" : "[ ]";
+            std::string name = e.id.empty() ? e.title : e.id + ". " + e.title;
+            if (name.size() > 50) name = name.substr(0, 47) + "...";
+
+            out << "  " << icon << " " << std::left << std::setw(static_cast<int>(title_width)) << name << "  "
+                << std::setw(7) << e.difficulty << " " << std::setw(16) << join(e.languages);
+            if (e.last_submit_at >= e.last_run_at && e.last_submit_at) {
+                out << " submit: " << e.last_submit_status << " (" << format_date(e.last_submit_at) << ")";
+            } else if (e.last_run_at) {
+                out << " run: " << e.last_run_status << " (" << format_date(e.last_run_at) << ")";
+            }
+            out << "\n";
+        }
+        out << entries.size() << (entries.size() == 1 ? " problem" : " problems") << "\n";
+        std::cout << out.str();
+    }
+}
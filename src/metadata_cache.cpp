@@ -0,0 +1,226 @@
+#include "metadata_cache.h"
+#include "utils.h"
+#include "leetcode_client.h"
+#include "trace.h"
+#include <nlohmann/json.hpp>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <regex>
+
+namespace leetcli {
+
+    namespace {
+        std::mutex cache_mutex;
+        bool cache_loaded = false;
+        int deferred_writers = 0;
+        bool dirty = false;
+        int64_t loaded_mtime = 0;
+        nlohmann::json cache_json = nlohmann::json::object();
+
+        std::filesystem::path cache_dir() {
+            return get_home() / ".leetcli/cache";
+        }
+
+        std::filesystem::path metadata_path() {
+            return cache_dir() / "metadata.json";
+        }
+
+        std::filesystem::path daily_path() {
+            return cache_dir() / "daily.json";
+        }
+
+        nlohmann::json read_json_file(const std::filesystem::path& path) {
+            std::ifstream in(path);
+            if (!in) return nlohmann::json::object();
+            try {
+                nlohmann::json j;
+                in >> j;
+                if (j.is_object()) return j;
+            } catch (const std::exception&) {
+                // A corrupt cache is the same as an empty one
+            }
+            return nlohmann::json::object();
+        }
+
+        int64_t mtime_of(const std::filesystem::path& path) {
+            std::error_code ec;
+            auto t = std::filesystem::last_write_time(path, ec);
+            return ec ? 0 : static_cast<int64_t>(t.time_since_epoch().count());
+        }
+
+        void write_json_file(const std::filesystem::path& path, const nlohmann::json& j) {
+            if (!write_file_atomic(path, j.dump(2))) {
+                std::cerr << "Failed to update cache: " << path << "\n";
+            }
+        }
+
+        void persist_metadata() {
+            if (deferred_writers > 0) {
+                dirty = true;
+                return;
+            }
+            write_json_file(metadata_path(), cache_json);
+            loaded_mtime = mtime_of(metadata_path());
+            dirty = false;
+        }
+
+        void ensure_loaded() {
+            // A long-lived process (leetclid, watch) re-reads the file when someone else rewrote it,
+            // unless it holds changes of its own that haven't been written yet
+            int64_t mtime = mtime_of(metadata_path());
+            if (!cache_loaded || (!dirty && mtime != loaded_mtime)) {
+                TraceSpan span("load metadata.json", "io");
+                cache_json = read_json_file(metadata_path());
+                loaded_mtime = mtime;
+                cache_loaded = true;
+            }
+        }
+
+        std::string utc_date_today() {
+            std::time_t now = std::time(nullptr);
+            std::tm tm{};
+#ifdef _WIN32
+            gmtime_s(&tm, &now);
+#else
+            gmtime_r(&now, &tm);
+#endif
+            char buf[16];
+            std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tm);
+            return buf;
+        }
+    }
+
+    std::string make_folder_name(const std::string& question_id, const std::string& title) {
+        std::string safe_title = std::regex_replace(title, std::regex("[\\\\/:*?\"<>|]"), "");
+        return question_id + ". " + safe_title;
+    }
+
+    std::optional<QuestionMeta> lookup_question_meta(const std::string& slug) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        ensure_loaded();
+        auto it = cache_json.find(slug);
+        if (it == cache_json.end() || !it->is_object()) return std::nullopt;
+
+        QuestionMeta meta;
+        meta.question_id = it->value("questionId", "");
+        meta.title = it->value("title", "");
+        meta.folder = it->value("folder", "");
+        if (meta.question_id.empty() || meta.folder.empty()) return std::nullopt;
+        return meta;
+    }
+
+    void store_question_meta(const std::string& slug, const QuestionMeta& meta) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        ensure_loaded();
+        cache_json[slug] = {
+            {"questionId", meta.question_id},
+            {"title", meta.title},
+            {"folder", meta.folder}
+        };
+        persist_metadata();
+    }
+
+    bool invalidate_question_meta(const std::string& slug) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        ensure_loaded();
+        if (cache_json.erase(slug) == 0) return false;
+        persist_metadata();
+        return true;
+    }
+
+    void clear_metadata_cache() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        cache_json = nlohmann::json::object();
+        cache_loaded = true;
+        loaded_mtime = 0;
+        std::error_code ec;
+        std::filesystem::remove(metadata_path(), ec);
+        std::filesystem::remove(daily_path(), ec);
+    }
+
+    MetadataWriteBatch::MetadataWriteBatch() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        ++deferred_writers;
+    }
+
+    MetadataWriteBatch::~MetadataWriteBatch() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (--deferred_writers == 0 && dirty) {
+            persist_metadata();
+        }
+    }
+
+    int resolve_question_meta(const std::string& slug, QuestionMeta& meta) {
+        if (auto cached = lookup_question_meta(slug)) {
+            meta = *cached;
+            return 0;
+        }
+
+        nlohmann::json query = {
+            {
+                "query", R"(
+            query getQuestionDetail($titleSlug: String!) {
+                question(titleSlug: $titleSlug) {
+                    title
+                    questionId
+                }
+            }
+        )"
+            },
+            {"variables", {{"titleSlug", slug}}}
+        };
+
+        cpr::Response r = client().graphql(query);
+
+        if (r.status_code != 200) {
+            std::cerr << "Failed to query problem info.\n";
+            return 1;
+        }
+
+        auto json = nlohmann::json::parse(r.text, nullptr, false);
+        if (json.is_discarded() || !json.contains("data") || json["data"].is_null() ||
+            !json["data"].contains("question") || json["data"]["question"].is_null()) {
+            std::cerr << "Problem not found. Check the title slug: \"" << slug << "\"\n";
+            return 1;
+        }
+
+        auto question = json["data"]["question"];
+        meta.question_id = question["questionId"];
+        meta.title = question["title"];
+        meta.folder = make_folder_name(meta.question_id, meta.title);
+        store_question_meta(slug, meta);
+        return 0;
+    }
+
+    std::optional<std::string> lookup_daily_slug() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        nlohmann::json daily = read_json_file(daily_path());
+        if (daily.value("date", "") != utc_date_today()) return std::nullopt;
+        std::string slug = daily.value("slug", "");
+        if (slug.empty()) return std::nullopt;
+        return slug;
+    }
+
+    void store_daily_slug(const std::string& slug) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        write_json_file(daily_path(), {{"date", utc_date_today()}, {"slug", slug}});
+    }
+
+    void handle_cache_command(const std::vector<std::string>& args) {
+        if (args.size() == 2 && args[1] == "clear") {
+            clear_metadata_cache();
+            std::cout << "✅ Metadata cache cleared.\n";
+        } else if (args.size() == 3 && args[1] == "clear") {
+            if (invalidate_question_meta(args[2])) {
+                std::cout << "✅ Removed cached metadata for " << args[2] << "\n";
+            } else {
+                std::cout << "No cached metadata for " << args[2] << "\n";
+            }
+        } else {
+            std::cerr << "Usage: leetcli cache clear [slug]\n";
+        }
+    }
+}
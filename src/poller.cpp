@@ -0,0 +1,136 @@
+#include "poller.h"
+#include "trace.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace leetcli {
+
+    Backoff::Backoff(const PollOptions& options)
+        : options_(options), current_ms_(static_cast<double>(options.first_delay.count())), rng_(std::random_device{}()) {}
+
+    std::chrono::milliseconds Backoff::next() {
+        std::uniform_real_distribution<double> spread(1.0 - options_.jitter, 1.0 + options_.jitter);
+        double delay = current_ms_ * spread(rng_);
+        current_ms_ = std::min(current_ms_ * options_.multiplier, static_cast<double>(options_.max_delay.count()));
+        return std::chrono::milliseconds(static_cast<long long>(delay));
+    }
+
+    CheckReply read_check_reply(const cpr::Response& r) {
+        CheckReply reply;
+        bool transient = r.status_code == 0 || r.status_code == 429 || r.status_code >= 500;
+        if (r.status_code != 200 && !transient) {
+            reply.error = "Polling failed: HTTP " + std::to_string(r.status_code);
+            return reply;
+        }
+
+        if (!transient) {
+            TraceSpan span("poll parse JSON", "json");
+            reply.body = nlohmann::json::parse(r.text, nullptr, false);
+            // An HTML error page or a reply without a state is retried like a 5xx
+            transient = reply.body.is_discarded() || !reply.body.is_object() || !reply.body.contains("state") ||
+                        !reply.body["state"].is_string();
+        }
+        if (transient) {
+            reply.state = CheckState::Transient;
+            reply.error = r.status_code == 200
+                ? "Unexpected response from judge"
+                : "Polling failed: HTTP " + std::to_string(r.status_code);
+            return reply;
+        }
+
+        const std::string& state = reply.body["state"].get_ref<const std::string&>();
+        if (state == "SUCCESS") {
+            reply.state = CheckState::Success;
+        } else if (state == "FAILURE") {
+            reply.state = CheckState::Failure;
+            reply.error = reply.body.value("status_msg", "Judge reported FAILURE");
+        } else {
+            // PENDING / STARTED: keep waiting
+            reply.state = CheckState::Pending;
+        }
+        return reply;
+    }
+
+    PollResult poll_until_done(const std::function<cpr::Response()>& check, const PollOptions& options) {
+        TraceSpan wait_span("judge wait", "poll");
+        using clock = std::chrono::steady_clock;
+        PollResult out;
+        Backoff backoff(options);
+        const auto start = clock::now();
+        const auto deadline = start + options.deadline;
+        int transient_errors = 0;
+
+        auto elapsed = [&] {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start);
+        };
+
+        while (true) {
+            // Judges usually finish in well under a second, so the first check comes early
+            auto delay = backoff.next();
+            if (clock::now() + delay > deadline) {
+                out.status = PollStatus::Timeout;
+                out.error = "Timed out waiting for the judge";
+                out.waited = elapsed();
+                return out;
+            }
+            // Sleep in short slices so a cancelled run doesn't sit out the whole delay
+            {
+                TraceSpan span("poll backoff sleep", "poll");
+                const auto wake = clock::now() + delay;
+                while (clock::now() < wake && !(options.cancel && *options.cancel)) {
+                    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(wake - clock::now());
+                    std::this_thread::sleep_for(std::min(left, std::chrono::milliseconds(50)));
+                }
+            }
+            if (options.cancel && *options.cancel) {
+                out.status = PollStatus::Cancelled;
+                out.error = "Cancelled";
+                out.waited = elapsed();
+                return out;
+            }
+
+            CheckReply reply = read_check_reply(check());
+            ++out.attempts;
+
+            if (reply.state == CheckState::Error) {
+                out.status = PollStatus::Error;
+                out.error = reply.error;
+                out.waited = elapsed();
+                return out;
+            }
+            if (reply.state == CheckState::Transient) {
+                if (++transient_errors > options.max_transient_errors) {
+                    out.status = PollStatus::Error;
+                    out.error = reply.error;
+                    out.waited = elapsed();
+                    return out;
+                }
+                continue;
+            }
+            transient_errors = 0;
+            out.result = std::move(reply.body);
+
+            if (reply.state == CheckState::Success) {
+                out.status = PollStatus::Success;
+                out.waited = elapsed();
+                return out;
+            }
+            if (reply.state == CheckState::Failure) {
+                out.status = PollStatus::Failure;
+                out.error = reply.error;
+                out.waited = elapsed();
+                return out;
+            }
+            // PENDING / STARTED: keep waiting
+        }
+    }
+
+    std::string describe_wait(const PollResult& result) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2) << (result.waited.count() / 1000.0) << " s, "
+            << result.attempts << (result.attempts == 1 ? " check" : " checks");
+        return out.str();
+    }
+}
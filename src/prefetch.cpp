@@ -0,0 +1,92 @@
+#include "prefetch.h"
+#include "bulk_fetch.h"
+#include "leetcode_api.h"
+#include "leetcode_client.h"
+#include "manifest.h"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace leetcli {
+
+    namespace {
+        void lower_priority() {
+#ifndef _WIN32
+            setpriority(PRIO_PROCESS, 0, 19);
+#endif
+#ifdef __linux__
+            // ioprio_set(IOPRIO_WHO_PROCESS, self, IOPRIO_CLASS_IDLE); glibc has no wrapper
+            const int who_process = 1;
+            const int class_idle = 3;
+            syscall(SYS_ioprio_set, who_process, 0, class_idle << 13);
+#endif
+        }
+
+        // The first `count` entries that haven't been accepted yet: the ones you're about to work on
+        std::vector<std::string> upcoming_slugs(const std::vector<std::string>& list, size_t count) {
+            std::set<std::string> accepted;
+            for (const auto& entry : load_manifest(false)) {
+                if (entry.accepted) accepted.insert(entry.slug);
+            }
+            std::vector<std::string> slugs;
+            for (const auto& slug : list) {
+                if (slugs.size() >= count) break;
+                if (!accepted.count(slug)) slugs.push_back(slug);
+            }
+            return slugs;
+        }
+    }
+
+    int prefetch(const std::string& list_path, const PrefetchOptions& options) {
+        if (options.low_priority) lower_priority();
+
+        // The budget is shared by all workers; curl enforces it per transfer
+        int jobs = std::max(options.jobs, 1);
+        set_transfer_rate_limit(options.rate_kb * 1024 / jobs);
+
+        std::vector<std::string> slugs;
+        if (options.daily) {
+            // Also caches the slug until midnight UTC, so `fetch daily` resolves it locally
+            try {
+                std::string daily = get_daily_question_slug();
+                if (!daily.empty()) slugs.push_back(daily);
+            } catch (const std::exception& e) {
+                std::cerr << "⚠️  Skipping the daily question: " << e.what() << "\n";
+            }
+        }
+
+        if (!list_path.empty()) {
+            std::ifstream in(list_path);
+            if (!in) {
+                std::cerr << "Could not open " << list_path << "\n";
+                return 1;
+            }
+            for (auto& slug : upcoming_slugs(read_slug_list(in), options.next)) {
+                if (std::find(slugs.begin(), slugs.end(), slug) == slugs.end()) slugs.push_back(slug);
+            }
+        }
+
+        if (slugs.empty()) {
+            if (!options.quiet) std::cout << "Nothing to prefetch.\n";
+            return 0;
+        }
+
+        BulkFetchOptions fetch_options;
+        fetch_options.jobs = jobs;
+        fetch_options.quiet = options.quiet;
+        fetch_options.lang_override = options.lang_override;
+        BulkFetchSummary summary = fetch_many(slugs, fetch_options);
+        if (!options.quiet || !summary.failures.empty()) print_bulk_summary(summary);
+        return summary.failures.empty() ? 0 : 1;
+    }
+}
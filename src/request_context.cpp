@@ -0,0 +1,74 @@
+#include "request_context.h"
+#include <iostream>
+
+namespace leetcli {
+
+    namespace {
+        thread_local const RequestContext* bound_request = nullptr;
+
+        // Unbuffered, so every write goes straight to the buffer of whichever request the writing
+        // thread serves; threads without one write to the process's own stream
+        class ThreadRoutedBuf : public std::streambuf {
+        public:
+            ThreadRoutedBuf(std::streambuf* fallback, bool is_err) : fallback_(fallback), is_err_(is_err) {}
+
+        protected:
+            int_type overflow(int_type ch) override {
+                if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+                char c = traits_type::to_char_type(ch);
+                return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+            }
+
+            std::streamsize xsputn(const char* s, std::streamsize n) override {
+                const RequestContext* request = bound_request;
+                if (!request) return fallback_->sputn(s, n);
+                std::lock_guard<std::mutex> lock(request->output_mutex);
+                (is_err_ ? request->err : request->out)->sputn(s, n);
+                return n; // a client that hung up must not leave std::cout failed for everyone else
+            }
+
+            int sync() override {
+                const RequestContext* request = bound_request;
+                if (!request) return fallback_->pubsync();
+                std::lock_guard<std::mutex> lock(request->output_mutex);
+                (is_err_ ? request->err : request->out)->pubsync();
+                return 0;
+            }
+
+        private:
+            std::streambuf* fallback_;
+            bool is_err_;
+        };
+    }
+
+    void route_output_per_thread() {
+        // Never freed: std::cout may be written to during static destruction
+        static ThreadRoutedBuf* out = new ThreadRoutedBuf(std::cout.rdbuf(), false);
+        static ThreadRoutedBuf* err = new ThreadRoutedBuf(std::cerr.rdbuf(), true);
+        std::cout.rdbuf(out);
+        std::cerr.rdbuf(err);
+    }
+
+    const RequestContext* current_request() {
+        return bound_request;
+    }
+
+    RequestScope::RequestScope(const RequestContext* request) : previous_(bound_request) {
+        if (request) bound_request = request;
+    }
+
+    RequestScope::~RequestScope() {
+        bound_request = previous_;
+    }
+
+    std::filesystem::path working_directory() {
+        if (bound_request && !bound_request->cwd.empty()) return bound_request->cwd;
+        std::error_code ec;
+        return std::filesystem::current_path(ec);
+    }
+
+    std::filesystem::path resolve_path(const std::string& path) {
+        std::filesystem::path p(path);
+        return p.is_absolute() ? p : working_directory() / p;
+    }
+}
@@ -0,0 +1,126 @@
+#include "result_cache.h"
+#include "utils.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace leetcli {
+
+    namespace {
+        std::filesystem::path result_path(const std::string& key) {
+            return get_home() / ".leetcli/cache/results" / (key + ".json");
+        }
+
+        // Whitespace at line ends and trailing blank lines don't change what the judge runs
+        std::string normalize_code(const std::string& code) {
+            std::string out;
+            std::string line;
+            for (size_t i = 0; i <= code.size(); ++i) {
+                if (i == code.size() || code[i] == '\n') {
+                    while (!line.empty() && (line.back() == ' ' || line.back() == '\t' || line.back() == '\r')) line.pop_back();
+                    out += line;
+                    out += '\n';
+                    line.clear();
+                } else {
+                    line += code[i];
+                }
+            }
+            while (out.size() > 1 && out[out.size() - 1] == '\n' && out[out.size() - 2] == '\n') out.pop_back();
+            return out;
+        }
+
+        std::optional<nlohmann::json> read_entry(const std::string& key) {
+            std::ifstream in(result_path(key));
+            if (!in) return std::nullopt;
+            nlohmann::json j = nlohmann::json::parse(in, nullptr, false);
+            if (j.is_discarded() || !j.is_object()) return std::nullopt;
+            return j;
+        }
+
+        void write_entry(const std::string& key, const nlohmann::json& j) {
+            write_file_atomic(result_path(key), j.dump());
+        }
+    }
+
+    std::string run_cache_key(const std::string& lang, const std::string& question_id, const std::string& code,
+                              const std::vector<std::string>& cases) {
+        std::string material = "run\n" + lang + "\n" + question_id + "\n" + normalize_code(code);
+        for (const auto& c : cases) material += "\n\x1e" + c; // record separator keeps case boundaries in the hash
+        return hash_hex(material);
+    }
+
+    std::string submit_cache_key(const std::string& lang, const std::string& question_id, const std::string& code) {
+        return hash_hex("submit\n" + lang + "\n" + question_id + "\n" + normalize_code(code));
+    }
+
+    std::optional<RunReport> lookup_run_result(const std::string& key) {
+        auto j = read_entry(key);
+        if (!j) return std::nullopt;
+
+        RunReport report;
+        report.ok = j->value("ok", false);
+        report.status_msg = j->value("status_msg", "");
+        report.compile_error = j->value("compile_error", "");
+        report.runtime = j->value("runtime", "N/A");
+        report.memory = j->value("memory", "N/A");
+        report.lang = j->value("lang", "");
+        report.cached = true;
+        for (const auto& row : j->value("cases", nlohmann::json::array())) {
+            TestCaseResult result;
+            result.input = row.value("input", "");
+            result.output = row.value("output", "");
+            result.expected = row.value("expected", "");
+            result.std_output = row.value("std_output", "");
+            result.passed = row.value("passed", false);
+            report.cases.push_back(result);
+        }
+        return report;
+    }
+
+    void store_run_result(const std::string& key, const RunReport& report) {
+        // Runtime errors and timeouts can be flaky on the judge side; only keep deterministic outcomes
+        if (!report.ok && report.compile_error.empty()) return;
+
+        nlohmann::json cases = nlohmann::json::array();
+        for (const auto& row : report.cases) {
+            cases.push_back({
+                {"input", row.input},
+                {"output", row.output},
+                {"expected", row.expected},
+                {"std_output", row.std_output},
+                {"passed", row.passed}
+            });
+        }
+        write_entry(key, {
+            {"ok", report.ok},
+            {"status_msg", report.status_msg},
+            {"compile_error", report.compile_error},
+            {"runtime", report.runtime},
+            {"memory", report.memory},
+            {"lang", report.lang},
+            {"cases", cases}
+        });
+    }
+
+    std::optional<CachedSubmission> lookup_submission(const std::string& key) {
+        auto j = read_entry(key);
+        if (!j) return std::nullopt;
+        CachedSubmission s;
+        s.status_msg = j->value("status_msg", "");
+        s.runtime = j->value("runtime", "N/A");
+        s.memory = j->value("memory", "N/A");
+        s.submission_id = j->value("submission_id", "");
+        s.submitted_at = j->value("submitted_at", int64_t{0});
+        return s;
+    }
+
+    void store_submission(const std::string& key, const CachedSubmission& submission) {
+        write_entry(key, {
+            {"status_msg", submission.status_msg},
+            {"runtime", submission.runtime},
+            {"memory", submission.memory},
+            {"submission_id", submission.submission_id},
+            {"submitted_at", submission.submitted_at}
+        });
+    }
+}
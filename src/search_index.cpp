@@ -0,0 +1,450 @@
+#include "search_index.h"
+#include "utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_set>
+
+namespace leetcli {
+
+    namespace {
+        const char kMagic[] = "LCSI1\n";
+
+        std::string index_path() {
+            return (get_workspace_state_dir() / "search.idx").string();
+        }
+
+        int64_t mtime_of(const std::filesystem::path& path) {
+            std::error_code ec;
+            auto t = std::filesystem::last_write_time(path, ec);
+            return ec ? 0 : static_cast<int64_t>(t.time_since_epoch().count());
+        }
+
+        void put_varint(std::string& out, uint64_t v) {
+            while (v >= 0x80) {
+                out += static_cast<char>((v & 0x7F) | 0x80);
+                v >>= 7;
+            }
+            out += static_cast<char>(v);
+        }
+
+        void put_string(std::string& out, const std::string& s) {
+            put_varint(out, s.size());
+            out += s;
+        }
+
+        struct Reader {
+            const std::string& data;
+            size_t pos = 0;
+            bool ok = true;
+
+            uint64_t varint() {
+                uint64_t v = 0;
+                int shift = 0;
+                while (pos < data.size() && shift < 64) {
+                    auto byte = static_cast<unsigned char>(data[pos++]);
+                    v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) return v;
+                    shift += 7;
+                }
+                ok = false;
+                return 0;
+            }
+
+            std::string string() {
+                uint64_t len = varint();
+                if (!ok || pos + len > data.size()) {
+                    ok = false;
+                    return "";
+                }
+                std::string s = data.substr(pos, len);
+                pos += len;
+                return s;
+            }
+        };
+
+        std::string read_file(const std::filesystem::path& path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) return "";
+            std::ostringstream ss;
+            ss << in.rdbuf();
+            return ss.str();
+        }
+
+        std::string lower(std::string s) {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+            return s;
+        }
+    }
+
+    std::vector<std::string> tokenize(const std::string& text) {
+        std::vector<std::string> tokens;
+        std::string current;
+        for (unsigned char c : text) {
+            if (std::isalnum(c)) {
+                current += static_cast<char>(std::tolower(c));
+            } else if (!current.empty()) {
+                tokens.push_back(std::move(current));
+                current.clear();
+            }
+        }
+        if (!current.empty()) tokens.push_back(std::move(current));
+        return tokens;
+    }
+
+    bool SearchIndex::load(const std::string& path) {
+        std::string data = read_file(path);
+        if (data.compare(0, sizeof(kMagic) - 1, kMagic) != 0) return false;
+
+        Reader r{data, sizeof(kMagic) - 1};
+        root_mtime_ = static_cast<int64_t>(r.varint());
+        uint64_t doc_count = r.varint();
+        docs_.clear();
+        doc_by_folder_.clear();
+        postings_.clear();
+        total_length_ = 0;
+        docs_.reserve(doc_count);
+        for (uint64_t i = 0; i < doc_count && r.ok; ++i) {
+            Doc d;
+            d.folder = r.string();
+            d.mtime = static_cast<int64_t>(r.varint());
+            d.length = static_cast<uint32_t>(r.varint());
+            d.title_length = static_cast<uint32_t>(r.varint());
+            d.live = true;
+            total_length_ += d.length;
+            doc_by_folder_[d.folder] = static_cast<uint32_t>(docs_.size());
+            docs_.push_back(std::move(d));
+        }
+
+        uint64_t term_count = r.varint();
+        postings_.reserve(term_count);
+        for (uint64_t t = 0; t < term_count && r.ok; ++t) {
+            std::string term = r.string();
+            uint64_t n = r.varint();
+            auto& list = postings_[term];
+            list.reserve(n);
+            uint32_t doc = 0;
+            for (uint64_t k = 0; k < n && r.ok; ++k) {
+                doc += static_cast<uint32_t>(r.varint());
+                Posting p{doc, {}};
+                uint64_t npos = r.varint();
+                p.positions.reserve(npos);
+                uint32_t pos = 0;
+                for (uint64_t j = 0; j < npos && r.ok; ++j) {
+                    pos += static_cast<uint32_t>(r.varint());
+                    p.positions.push_back(pos);
+                }
+                list.push_back(std::move(p));
+            }
+        }
+
+        if (!r.ok) {
+            *this = SearchIndex();
+            return false;
+        }
+        return true;
+    }
+
+    bool SearchIndex::save(const std::string& path) const {
+        // Dead documents are dropped here, so ids are compact again after every save
+        std::vector<uint32_t> remap(docs_.size(), UINT32_MAX);
+        uint32_t next = 0;
+        for (size_t i = 0; i < docs_.size(); ++i) {
+            if (docs_[i].live) remap[i] = next++;
+        }
+
+        std::string out(kMagic);
+        out.reserve(1 << 20);
+        put_varint(out, static_cast<uint64_t>(root_mtime_));
+        put_varint(out, next);
+        for (const auto& d : docs_) {
+            if (!d.live) continue;
+            put_string(out, d.folder);
+            put_varint(out, static_cast<uint64_t>(d.mtime));
+            put_varint(out, d.length);
+            put_varint(out, d.title_length);
+        }
+
+        size_t term_count = 0;
+        for (const auto& [term, list] : postings_) {
+            if (!list.empty()) ++term_count;
+        }
+        put_varint(out, term_count);
+        for (const auto& [term, list] : postings_) {
+            if (list.empty()) continue;
+            put_string(out, term);
+            put_varint(out, list.size());
+            uint32_t prev_doc = 0;
+            for (const auto& p : list) {
+                uint32_t doc = remap[p.doc];
+                put_varint(out, doc - prev_doc);
+                prev_doc = doc;
+                put_varint(out, p.positions.size());
+                uint32_t prev_pos = 0;
+                for (uint32_t pos : p.positions) {
+                    put_varint(out, pos - prev_pos);
+                    prev_pos = pos;
+                }
+            }
+        }
+        return write_file_atomic(path, out);
+    }
+
+    void SearchIndex::remove_doc(uint32_t id) {
+        if (id >= docs_.size() || !docs_[id].live) return;
+        for (auto& [term, list] : postings_) {
+            auto it = std::lower_bound(list.begin(), list.end(), id, [](const Posting& p, uint32_t d) { return p.doc < d; });
+            if (it != list.end() && it->doc == id) list.erase(it);
+        }
+        total_length_ -= docs_[id].length;
+        docs_[id].live = false;
+        doc_by_folder_.erase(docs_[id].folder);
+    }
+
+    void SearchIndex::add_doc(const std::string& folder, int64_t mtime, const std::string& text) {
+        auto id = static_cast<uint32_t>(docs_.size());
+        size_t title_end = text.find('\n');
+        std::vector<std::string> title_tokens = tokenize(text.substr(0, title_end));
+        std::vector<std::string> tokens = tokenize(text);
+
+        Doc d;
+        d.folder = folder;
+        d.mtime = mtime;
+        d.length = static_cast<uint32_t>(tokens.size());
+        d.title_length = static_cast<uint32_t>(title_tokens.size());
+        d.live = true;
+
+        // Ids only grow, so appending keeps every posting list sorted by doc
+        std::unordered_map<std::string, std::vector<uint32_t>> positions;
+        for (uint32_t i = 0; i < tokens.size(); ++i) positions[tokens[i]].push_back(i);
+        for (auto& [term, pos] : positions) postings_[term].push_back({id, std::move(pos)});
+
+        total_length_ += d.length;
+        doc_by_folder_[folder] = id;
+        docs_.push_back(std::move(d));
+    }
+
+    void SearchIndex::index_folder(const std::string& folder_path) {
+        std::filesystem::path readme = std::filesystem::path(folder_path) / "README.md";
+        std::string folder = std::filesystem::path(folder_path).filename().string();
+        if (auto it = doc_by_folder_.find(folder); it != doc_by_folder_.end()) remove_doc(it->second);
+        if (!std::filesystem::exists(readme)) return;
+        add_doc(folder, mtime_of(readme), read_file(readme));
+    }
+
+    size_t SearchIndex::refresh(const std::string& problems_dir, bool force_scan) {
+        // New or removed problem folders change the directory mtime; nothing to do if it didn't move
+        int64_t root = mtime_of(problems_dir);
+        if (!force_scan && root == root_mtime_) return 0;
+
+        size_t changed = 0;
+        std::unordered_set<std::string> seen;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(problems_dir, ec)) {
+            std::string folder = entry.path().filename().string();
+            if (!entry.is_directory() || folder[0] == '.') continue;
+            std::filesystem::path readme = entry.path() / "README.md";
+            int64_t mtime = mtime_of(readme);
+            if (mtime == 0) continue;
+            seen.insert(folder);
+
+            auto it = doc_by_folder_.find(folder);
+            if (it != doc_by_folder_.end() && docs_[it->second].mtime == mtime) continue;
+            index_folder(entry.path().string());
+            ++changed;
+        }
+
+        for (uint32_t id = 0; id < docs_.size(); ++id) {
+            if (docs_[id].live && !seen.count(docs_[id].folder)) {
+                remove_doc(id);
+                ++changed;
+            }
+        }
+        root_mtime_ = root;
+        return changed;
+    }
+
+    size_t SearchIndex::document_count() const {
+        return doc_by_folder_.size();
+    }
+
+    const SearchIndex::Posting* SearchIndex::find_posting(const std::string& term, uint32_t doc) const {
+        auto it = postings_.find(term);
+        if (it == postings_.end()) return nullptr;
+        const auto& list = it->second;
+        auto p = std::lower_bound(list.begin(), list.end(), doc, [](const Posting& x, uint32_t d) { return x.doc < d; });
+        return p != list.end() && p->doc == doc ? &*p : nullptr;
+    }
+
+    bool SearchIndex::has_phrase(uint32_t doc, const std::vector<std::string>& phrase) const {
+        std::vector<const Posting*> lists;
+        for (const auto& term : phrase) {
+            const Posting* p = find_posting(term, doc);
+            if (!p) return false;
+            lists.push_back(p);
+        }
+        for (uint32_t start : lists[0]->positions) {
+            bool all = true;
+            for (size_t k = 1; k < lists.size() && all; ++k) {
+                all = std::binary_search(lists[k]->positions.begin(), lists[k]->positions.end(), start + static_cast<uint32_t>(k));
+            }
+            if (all) return true;
+        }
+        return false;
+    }
+
+    std::vector<SearchHit> SearchIndex::search(const std::string& query, size_t limit) const {
+        std::vector<std::string> terms;
+        std::vector<std::vector<std::string>> phrases;
+
+        // Split the query into "quoted phrases" and loose words
+        bool quoted = false;
+        std::string chunk;
+        auto flush = [&] {
+            auto tokens = tokenize(chunk);
+            if (quoted && tokens.size() > 1) phrases.push_back(tokens);
+            terms.insert(terms.end(), tokens.begin(), tokens.end());
+            chunk.clear();
+        };
+        for (char c : query) {
+            if (c == '"') {
+                flush();
+                quoted = !quoted;
+            } else {
+                chunk += c;
+            }
+        }
+        flush();
+
+        std::sort(terms.begin(), terms.end());
+        terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+        if (terms.empty() || doc_by_folder_.empty()) return {};
+
+        const double k1 = 1.2, b = 0.75;
+        const double n_docs = static_cast<double>(doc_by_folder_.size());
+        const double avg_len = std::max(1.0, static_cast<double>(total_length_) / n_docs);
+
+        std::unordered_map<uint32_t, double> scores;
+        for (const auto& term : terms) {
+            auto it = postings_.find(term);
+            if (it == postings_.end() || it->second.empty()) continue;
+            const auto& list = it->second;
+            double df = static_cast<double>(list.size());
+            double idf = std::log(1.0 + (n_docs - df + 0.5) / (df + 0.5));
+            for (const auto& p : list) {
+                const Doc& d = docs_[p.doc];
+                if (!d.live) continue;
+                double tf = static_cast<double>(p.positions.size());
+                double score = idf * tf * (k1 + 1) / (tf + k1 * (1 - b + b * d.length / avg_len));
+                // Matches in the title count extra
+                if (!p.positions.empty() && p.positions.front() < d.title_length) score += idf;
+                scores[p.doc] += score;
+            }
+        }
+
+        std::vector<SearchHit> hits;
+        for (const auto& [doc, score] : scores) {
+            bool ok = true;
+            for (const auto& phrase : phrases) {
+                if (!has_phrase(doc, phrase)) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (ok) hits.push_back({docs_[doc].folder, score});
+        }
+
+        std::sort(hits.begin(), hits.end(), [](const SearchHit& a, const SearchHit& c) {
+            return a.score != c.score ? a.score > c.score : a.folder < c.folder;
+        });
+        if (limit && hits.size() > limit) hits.resize(limit);
+        return hits;
+    }
+
+    void update_search_index(const std::vector<std::string>& folder_paths) {
+        if (folder_paths.empty()) return;
+        std::string problems_dir = get_problems_dir();
+        std::string path = index_path();
+
+        SearchIndex index;
+        bool existed = index.load(path);
+        if (!existed) {
+            index.refresh(problems_dir, true); // first index build covers everything already on disk
+        } else {
+            for (const auto& folder : folder_paths) index.index_folder(folder);
+        }
+        index.save(path);
+    }
+
+    void handle_search_command(const std::vector<std::string>& args) {
+        std::string query;
+        size_t limit = 10;
+        bool reindex = false;
+        for (size_t i = 1; i < args.size(); ++i) {
+            if (args[i].rfind("--limit=", 0) == 0) {
+                limit = static_cast<size_t>(std::max(0, std::atoi(args[i].substr(8).c_str())));
+            } else if (args[i] == "--reindex") {
+                reindex = true;
+            } else {
+                query += (query.empty() ? "" : " ") + args[i];
+            }
+        }
+        if (query.empty() && !reindex) {
+            std::cerr << "Usage: leetcli search <words or \"a phrase\"> [--limit=N] [--reindex]\n";
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::string problems_dir = get_problems_dir();
+        std::string path = index_path();
+
+        SearchIndex index;
+        if (reindex) {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        } else {
+            index.load(path);
+        }
+        if (index.refresh(problems_dir, reindex) > 0 || reindex) {
+            index.save(path);
+        }
+        if (query.empty()) {
+            std::cout << "✅ Indexed " << index.document_count() << " problems.\n";
+            return;
+        }
+
+        auto hits = index.search(query, limit);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        auto terms = tokenize(query);
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2);
+        for (size_t i = 0; i < hits.size(); ++i) {
+            out << std::setw(3) << (i + 1) << ". " << hits[i].folder << "  (" << hits[i].score << ")\n";
+
+            // First line of the statement that mentions a query word
+            std::ifstream readme(std::filesystem::path(problems_dir) / hits[i].folder / "README.md");
+            std::string line;
+            std::getline(readme, line); // title
+            while (std::getline(readme, line)) {
+                std::string l = lower(line);
+                bool hit = std::any_of(terms.begin(), terms.end(), [&](const std::string& t) { return l.find(t) != std::string::npos; });
+                if (!hit) continue;
+                size_t b = line.find_first_not_of(" \t-");
+                line = b == std::string::npos ? "" : line.substr(b);
+                if (line.size() > 100) line = line.substr(0, 97) + "...";
+                out << "       " << line << "\n";
+                break;
+            }
+        }
+        out << std::setprecision(1);
+        out << hits.size() << (hits.size() == 1 ? " result" : " results") << " in " << ms << " ms ("
+            << index.document_count() << " problems indexed)\n";
+        std::cout << out.str();
+    }
+}
@@ -0,0 +1,267 @@
+#include "submit_queue.h"
+#include "leetcode_api.h"
+#include "leetcode_client.h"
+#include "manifest.h"
+#include "poller.h"
+#include "result_cache.h"
+#include "trace.h"
+#include "utils.h"
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+namespace leetcli {
+
+    namespace {
+        using clock = std::chrono::steady_clock;
+
+        constexpr int kMaxRateLimitRetries = 5;
+
+        struct QueuedSubmission {
+            std::string slug;
+            std::optional<PreparedSubmission> prepared;
+            std::string submission_id;
+            bool judging = false;
+
+            std::optional<Backoff> backoff;
+            clock::time_point posted_at;
+            clock::time_point next_check;
+            int transient_errors = 0;
+            int rate_limited = 0;
+
+            // What the summary shows
+            std::string status;
+            std::string runtime;
+            std::string memory;
+            std::string note;            // error detail or "cached"
+            std::chrono::milliseconds waited{0};
+        };
+
+        std::string trim(const std::string& s) {
+            size_t b = s.find_first_not_of(" \t\r\n");
+            if (b == std::string::npos) return "";
+            size_t e = s.find_last_not_of(" \t\r\n");
+            return s.substr(b, e - b + 1);
+        }
+
+        std::string seconds(std::chrono::milliseconds ms) {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(2) << ms.count() / 1000.0 << " s";
+            return out.str();
+        }
+
+        // Unix seconds, to compare with the manifest's last_submit_at
+        int64_t unix_mtime(const std::filesystem::path& path) {
+            std::error_code ec;
+            auto t = std::filesystem::last_write_time(path, ec);
+            if (ec) return 0;
+            auto sys = std::chrono::time_point_cast<std::chrono::seconds>(
+                t - std::filesystem::file_time_type::clock::now() + std::chrono::system_clock::now());
+            return sys.time_since_epoch().count();
+        }
+
+        bool matches_starter(const std::filesystem::path& solution, const std::string& folder, const std::string& lang) {
+            std::ifstream in(std::filesystem::path(folder) / "problem.json");
+            if (!in) return false;
+            auto question = nlohmann::json::parse(in, nullptr, false);
+            if (question.is_discarded() || !question.is_object()) return false;
+
+            std::ifstream code_in(solution);
+            std::string code((std::istreambuf_iterator<char>(code_in)), std::istreambuf_iterator<char>());
+            for (const auto& snippet : question.value("codeSnippets", nlohmann::json::array())) {
+                if (snippet.value("langSlug", "") == lang) return trim(snippet.value("code", "")) == trim(code);
+            }
+            return false;
+        }
+
+        void print_verdict(const QueuedSubmission& s, size_t done, size_t total) {
+            bool accepted = s.status == "Accepted";
+            std::cout << "[" << done << "/" << total << "] " << (accepted ? "✅ " : "❌ ") << s.slug << " — " << s.status;
+            if (!s.runtime.empty()) std::cout << " (" << s.runtime << ", " << s.memory << ")";
+            if (!s.note.empty()) std::cout << " — " << s.note;
+            std::cout << std::endl;
+        }
+
+        void print_summary(const std::vector<QueuedSubmission>& queue, std::chrono::milliseconds total) {
+            size_t slug_width = 7;
+            size_t status_width = 6;
+            for (const auto& s : queue) {
+                slug_width = std::max(slug_width, s.slug.size());
+                status_width = std::max(status_width, s.status.size());
+            }
+            std::ostringstream out;
+            out << "\n" << std::left << std::setw(static_cast<int>(slug_width)) << "Problem" << "  "
+                << std::setw(static_cast<int>(status_width)) << "Result" << "  "
+                << std::setw(10) << "Runtime" << "  " << std::setw(10) << "Memory" << "  Judged in\n";
+            for (const auto& s : queue) {
+                out << std::setw(static_cast<int>(slug_width)) << s.slug << "  "
+                    << std::setw(static_cast<int>(status_width)) << s.status << "  "
+                    << std::setw(10) << (s.runtime.empty() ? "-" : s.runtime) << "  "
+                    << std::setw(10) << (s.memory.empty() ? "-" : s.memory) << "  "
+                    << (s.note == "cached" ? "cached" : s.waited.count() ? seconds(s.waited) : "-") << "\n";
+            }
+            size_t accepted = std::count_if(queue.begin(), queue.end(), [](const QueuedSubmission& s) { return s.status == "Accepted"; });
+            out << std::right << accepted << "/" << queue.size() << " accepted in " << seconds(total) << "\n";
+            std::cout << out.str();
+        }
+    }
+
+    std::vector<std::string> changed_solutions(const std::string& lang_override) {
+        std::string lang = lang_override.empty() ? get_preferred_language() : lang_override;
+        auto ext = solution_extension(lang);
+        if (!ext) {
+            std::cerr << "Unsupported language: " << lang << "\n";
+            return {};
+        }
+
+        std::vector<std::string> slugs;
+        std::string problems_dir = get_problems_dir();
+        for (const auto& entry : load_manifest(false)) {
+            if (entry.slug.empty()) continue;
+            std::string folder = problems_dir + "/" + entry.folder;
+            std::filesystem::path solution = std::filesystem::path(folder) / ("solution" + *ext);
+            if (!std::filesystem::exists(solution)) continue;
+
+            if (entry.last_submit_at) {
+                if (unix_mtime(solution) > entry.last_submit_at) slugs.push_back(entry.slug);
+            } else if (!matches_starter(solution, folder, lang)) {
+                slugs.push_back(entry.slug);
+            }
+        }
+        return slugs;
+    }
+
+    int submit_many(const std::vector<std::string>& slugs, const SubmitQueueOptions& options) {
+        TraceSpan batch_span("submit batch");
+        const auto start = clock::now();
+        std::vector<QueuedSubmission> queue(slugs.size());
+        std::deque<size_t> to_post;
+        size_t finished = 0;
+
+        auto finish = [&](QueuedSubmission& s) {
+            s.judging = false;
+            print_verdict(s, ++finished, queue.size());
+        };
+
+        // Everything local first: reading code, metadata and the Accepted cache needs no network
+        for (size_t i = 0; i < slugs.size(); ++i) {
+            QueuedSubmission& s = queue[i];
+            s.slug = slugs[i];
+            std::string error;
+            s.prepared = prepare_submission(s.slug, options.lang_override, error);
+            if (!s.prepared) {
+                s.status = "Skipped";
+                s.note = error.empty() ? "no solution file" : error;
+                finish(s);
+                continue;
+            }
+            if (auto previous = lookup_submission(s.prepared->cache_key);
+                previous && previous->status_msg == "Accepted" && !options.force) {
+                s.status = previous->status_msg;
+                s.runtime = previous->runtime;
+                s.memory = previous->memory;
+                s.note = "cached";
+                finish(s);
+                continue;
+            }
+            to_post.push_back(i);
+        }
+
+        PollOptions poll_options;
+        PollOptions rate_options;
+        rate_options.first_delay = std::max(options.interval * 2, std::chrono::milliseconds(1000));
+        rate_options.max_delay = std::chrono::seconds(60);
+        rate_options.multiplier = 2.0;
+        Backoff rate_backoff(rate_options);
+        auto next_post = clock::now();
+
+        while (finished < queue.size()) {
+            auto now = clock::now();
+
+            // Post at most one submission per turn, spaced out by the interval
+            if (!to_post.empty() && now >= next_post) {
+                QueuedSubmission& s = queue[to_post.front()];
+                SubmitPost posted = post_submission(*s.prepared);
+                now = clock::now();
+                if (posted.status_code == 429 && ++s.rate_limited <= kMaxRateLimitRetries) {
+                    auto delay = rate_backoff.next();
+                    std::cout << "⏳ Rate limited; retrying " << s.slug << " in " << seconds(delay) << std::endl;
+                    next_post = now + delay;
+                    continue;
+                }
+                to_post.pop_front();
+                next_post = now + options.interval;
+                if (posted.submission_id.empty()) {
+                    s.status = "Not submitted";
+                    s.note = posted.error;
+                    finish(s);
+                    continue;
+                }
+                rate_backoff = Backoff(rate_options);
+                s.submission_id = posted.submission_id;
+                s.judging = true;
+                s.posted_at = now;
+                s.backoff.emplace(poll_options);
+                s.next_check = now + s.backoff->next();
+            }
+
+            // Check every submission that is due; all share one thread and one connection
+            for (auto& s : queue) {
+                if (!s.judging || clock::now() < s.next_check) continue;
+                CheckReply reply = read_check_reply(client().get(
+                    "https://leetcode.com/submissions/detail/" + s.submission_id + "/check/", Auth::Session,
+                    "https://leetcode.com/problems/" + s.slug + "/"));
+                now = clock::now();
+                s.waited = std::chrono::duration_cast<std::chrono::milliseconds>(now - s.posted_at);
+
+                if (reply.state == CheckState::Success) {
+                    s.status = reply.body.value("status_msg", "Unknown");
+                    s.runtime = reply.body.value("status_runtime", "N/A");
+                    s.memory = reply.body.value("status_memory", "N/A");
+                    record_verdict(*s.prepared, s.submission_id, reply.body);
+                    finish(s);
+                    continue;
+                }
+                bool give_up = reply.state == CheckState::Failure || reply.state == CheckState::Error ||
+                               (reply.state == CheckState::Transient && ++s.transient_errors > poll_options.max_transient_errors);
+                if (!give_up && now - s.posted_at > options.deadline) {
+                    give_up = true;
+                    reply.error = "Timed out waiting for the judge";
+                }
+                if (give_up) {
+                    if (reply.state == CheckState::Failure) {
+                        s.status = reply.error;
+                    } else {
+                        s.status = "Unknown";
+                        s.note = reply.error + "; see https://leetcode.com/submissions/detail/" + s.submission_id + "/";
+                    }
+                    finish(s);
+                    continue;
+                }
+                if (reply.state != CheckState::Transient) s.transient_errors = 0;
+                s.next_check = now + s.backoff->next();
+            }
+
+            // Sleep until the next post or check is due
+            std::optional<clock::time_point> wake;
+            if (!to_post.empty()) wake = next_post;
+            for (const auto& s : queue) {
+                if (s.judging && (!wake || s.next_check < *wake)) wake = s.next_check;
+            }
+            if (wake && *wake > clock::now()) {
+                TraceSpan span("poll backoff sleep", "poll");
+                std::this_thread::sleep_until(*wake);
+            }
+        }
+
+        print_summary(queue, std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start));
+        bool all_accepted = std::all_of(queue.begin(), queue.end(), [](const QueuedSubmission& s) { return s.status == "Accepted"; });
+        return all_accepted ? 0 : 1;
+    }
+}
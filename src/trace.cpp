@@ -0,0 +1,217 @@
+#include "trace.h"
+#include "utils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace leetcli {
+
+    namespace detail {
+        std::atomic<bool> trace_on{false};
+    }
+
+    namespace {
+        using clock = std::chrono::steady_clock;
+
+        struct TraceEvent {
+            std::string name;
+            const char* category;
+            int64_t start_us;
+            int64_t duration_us;
+            int tid;
+            nlohmann::json args;
+        };
+
+        struct HttpPhases {
+            int64_t dns = 0, connect = 0, tls = 0, server = 0, transfer = 0;
+        };
+
+        std::mutex trace_mutex;
+        clock::time_point trace_start;
+        std::string chrome_path;
+        std::vector<TraceEvent> events;
+        std::map<std::thread::id, int> thread_ids;
+        HttpPhases http_totals;
+        size_t http_calls = 0;
+
+        int64_t micros_since_start(clock::time_point t) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(t - trace_start).count();
+        }
+
+        // Caller holds trace_mutex
+        int current_tid() {
+            auto [it, inserted] = thread_ids.emplace(std::this_thread::get_id(), static_cast<int>(thread_ids.size()) + 1);
+            return it->second;
+        }
+
+        // "/submissions/detail/1234567/check/" -> "/submissions/detail/*/check/", so polls group together
+        std::string path_label(const std::string& url) {
+            std::string path = url.substr(0, url.find('?'));
+            size_t scheme = path.find("://");
+            if (scheme != std::string::npos) path = path.substr(scheme + 3);
+
+            // The host is kept as is; only path segments are collapsed
+            size_t host_end = std::min(path.find('/'), path.size());
+            std::string label = path.substr(0, host_end), segment;
+            auto flush = [&] {
+                size_t digits = std::count_if(segment.begin(), segment.end(), [](unsigned char c) { return std::isdigit(c); });
+                label += digits >= 4 ? "*" : segment;
+                segment.clear();
+            };
+            for (char c : path.substr(host_end)) {
+                if (c == '/') {
+                    flush();
+                    label += '/';
+                } else {
+                    segment += c;
+                }
+            }
+            flush();
+            return label;
+        }
+
+        int64_t info_us(CURL* handle, CURLINFO info) {
+            curl_off_t value = 0;
+            return curl_easy_getinfo(handle, info, &value) == CURLE_OK ? static_cast<int64_t>(value) : 0;
+        }
+
+        std::string format_ms(int64_t us) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.1f", us / 1000.0);
+            return buf;
+        }
+
+        void print_summary(int64_t wall_us) {
+            struct Row {
+                size_t count = 0;
+                int64_t total = 0;
+                int64_t max = 0;
+            };
+            std::map<std::string, Row> rows;
+            for (const auto& e : events) {
+                if (std::string_view(e.category) == "http.phase") continue; // summed up in the phases line instead
+                Row& row = rows[e.name];
+                ++row.count;
+                row.total += e.duration_us;
+                row.max = std::max(row.max, e.duration_us);
+            }
+            std::vector<std::pair<std::string, Row>> sorted(rows.begin(), rows.end());
+            std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.total > b.second.total; });
+
+            size_t width = 4;
+            for (const auto& [name, row] : sorted) width = std::max(width, name.size());
+
+            std::cerr << "\n⏱️  Trace: " << format_ms(wall_us) << " ms wall\n";
+            char line[512];
+            std::snprintf(line, sizeof(line), "  %-*s %6s %10s %9s %9s\n", static_cast<int>(width), "span", "count", "total ms", "avg ms", "max ms");
+            std::cerr << line;
+            for (const auto& [name, row] : sorted) {
+                std::snprintf(line, sizeof(line), "  %-*s %6zu %10s %9s %9s\n", static_cast<int>(width), name.c_str(), row.count,
+                              format_ms(row.total).c_str(), format_ms(row.total / static_cast<int64_t>(row.count)).c_str(),
+                              format_ms(row.max).c_str());
+                std::cerr << line;
+            }
+            if (http_calls) {
+                std::cerr << "  HTTP phases over " << http_calls << (http_calls == 1 ? " call" : " calls") << ": dns "
+                          << format_ms(http_totals.dns) << " ms · connect " << format_ms(http_totals.connect) << " ms · tls "
+                          << format_ms(http_totals.tls) << " ms · server " << format_ms(http_totals.server) << " ms · transfer "
+                          << format_ms(http_totals.transfer) << " ms\n";
+            }
+        }
+
+        void write_chrome_trace() {
+            nlohmann::json trace_events = nlohmann::json::array();
+            for (const auto& e : events) {
+                nlohmann::json event = {
+                    {"name", e.name}, {"cat", e.category}, {"ph", "X"}, {"ts", e.start_us},
+                    {"dur", e.duration_us}, {"pid", 1}, {"tid", e.tid}
+                };
+                if (!e.args.is_null()) event["args"] = e.args;
+                trace_events.push_back(std::move(event));
+            }
+            nlohmann::json trace = {{"traceEvents", trace_events}, {"displayTimeUnit", "ms"}};
+            if (write_file_atomic(chrome_path, trace.dump())) {
+                std::cerr << "  Chrome trace written to " << chrome_path << "\n";
+            } else {
+                std::cerr << "  Failed to write " << chrome_path << "\n";
+            }
+        }
+    }
+
+    void enable_trace(const std::string& chrome_trace_path) {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        trace_start = clock::now();
+        chrome_path = chrome_trace_path;
+        detail::trace_on = true;
+    }
+
+    void finish_trace() {
+        if (!trace_enabled()) return;
+        detail::trace_on = false;
+
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        print_summary(micros_since_start(clock::now()));
+        if (!chrome_path.empty()) write_chrome_trace();
+    }
+
+    TraceSpan::~TraceSpan() {
+        if (!active_) return;
+        auto end = clock::now();
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        events.push_back({name_, category_, micros_since_start(start_),
+                          std::chrono::duration_cast<std::chrono::microseconds>(end - start_).count(), current_tid(), nullptr});
+    }
+
+    void trace_http(const char* method, const std::string& url, CURL* handle, long status_code) {
+        if (!trace_enabled() || !handle) return;
+        auto end = clock::now();
+
+        // curl reports each phase as time since the transfer started
+        int64_t namelookup = info_us(handle, CURLINFO_NAMELOOKUP_TIME_T);
+        int64_t connect = info_us(handle, CURLINFO_CONNECT_TIME_T);
+        int64_t appconnect = info_us(handle, CURLINFO_APPCONNECT_TIME_T);
+        int64_t pretransfer = info_us(handle, CURLINFO_PRETRANSFER_TIME_T);
+        int64_t starttransfer = info_us(handle, CURLINFO_STARTTRANSFER_TIME_T);
+        int64_t total = info_us(handle, CURLINFO_TOTAL_TIME_T);
+
+        HttpPhases phases;
+        phases.dns = namelookup;
+        phases.connect = std::max<int64_t>(0, connect - namelookup);
+        phases.tls = appconnect > 0 ? std::max<int64_t>(0, appconnect - connect) : 0;
+        phases.server = std::max<int64_t>(0, starttransfer - pretransfer);
+        phases.transfer = std::max<int64_t>(0, total - starttransfer);
+
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        int64_t start_us = micros_since_start(end) - total;
+        int tid = current_tid();
+        std::string name = std::string("HTTP ") + method + " " + path_label(url);
+        events.push_back({name, "http", start_us, total, tid,
+                          {{"url", url.substr(0, url.find('?'))}, {"status", status_code},
+                           {"dns_ms", phases.dns / 1000.0}, {"connect_ms", phases.connect / 1000.0},
+                           {"tls_ms", phases.tls / 1000.0}, {"server_ms", phases.server / 1000.0},
+                           {"transfer_ms", phases.transfer / 1000.0}}});
+
+        // Nested slices so Perfetto shows where the request's time went
+        int64_t at = start_us;
+        for (const auto& [phase, us] : {std::pair<const char*, int64_t>{"dns", phases.dns}, {"connect", phases.connect},
+                                        {"tls", phases.tls}, {"request sent", std::max<int64_t>(0, pretransfer - std::max(appconnect, connect))},
+                                        {"server", phases.server}, {"transfer", phases.transfer}}) {
+            if (us > 0) events.push_back({phase, "http.phase", at, us, tid, nullptr});
+            at += us;
+        }
+
+        ++http_calls;
+        http_totals.dns += phases.dns;
+        http_totals.connect += phases.connect;
+        http_totals.tls += phases.tls;
+        http_totals.server += phases.server;
+        http_totals.transfer += phases.transfer;
+    }
+}
@@ -0,0 +1,134 @@
+#include "transport.h"
+#include "utils.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <regex>
+#include <thread>
+#include <vector>
+
+namespace leetcli {
+
+    namespace {
+        struct Interaction {
+            std::string method;
+            std::string url;
+            std::string body;
+            long status = 0;
+            std::string text;
+            double elapsed = 0; // seconds, like cpr::Response::elapsed
+            bool used = false;
+        };
+
+        std::mutex transport_mutex;
+        TransportOptions current;
+        std::vector<Interaction> interactions;
+
+        // API keys travel in the query string (Gemini); cassettes must not keep them
+        std::string redact(const std::string& url) {
+            static const std::regex key_param("([?&](key|api_key)=)[^&]*");
+            return std::regex_replace(url, key_param, "$1REDACTED");
+        }
+
+        void load_cassette() {
+            interactions.clear();
+            std::ifstream in(current.cassette_path);
+            if (!in) return;
+            nlohmann::json j = nlohmann::json::parse(in, nullptr, false);
+            if (j.is_discarded() || !j.is_object()) {
+                std::cerr << "⚠️  Ignoring unreadable cassette " << current.cassette_path << "\n";
+                return;
+            }
+            for (const auto& item : j.value("interactions", nlohmann::json::array())) {
+                Interaction i;
+                i.method = item.value("method", "");
+                i.url = item.value("url", "");
+                i.body = item.value("body", "");
+                i.status = item.value("status", 0L);
+                i.text = item.value("response", "");
+                i.elapsed = item.value("elapsed", 0.0);
+                interactions.push_back(std::move(i));
+            }
+        }
+
+        void save_cassette() {
+            nlohmann::json list = nlohmann::json::array();
+            for (const auto& i : interactions) {
+                list.push_back({{"method", i.method}, {"url", i.url}, {"body", i.body}, {"status", i.status},
+                                {"response", i.text}, {"elapsed", i.elapsed}});
+            }
+            nlohmann::json j = {{"version", 1}, {"interactions", list}};
+            if (!write_file_atomic(current.cassette_path, j.dump(2))) {
+                std::cerr << "⚠️  Failed to write cassette " << current.cassette_path << "\n";
+            }
+        }
+    }
+
+    void configure_transport(const TransportOptions& options) {
+        std::lock_guard<std::mutex> lock(transport_mutex);
+        current = options;
+        interactions.clear();
+        // Recording into an existing cassette adds to it, so one file can cover a whole session
+        if (current.mode != TransportMode::Passthrough) load_cassette();
+        if (current.mode == TransportMode::Replay && interactions.empty()) {
+            std::cerr << "⚠️  Cassette " << current.cassette_path << " has no recorded requests; every request will fail.\n";
+        }
+    }
+
+    TransportMode transport_mode() {
+        std::lock_guard<std::mutex> lock(transport_mutex);
+        return current.mode;
+    }
+
+    std::optional<cpr::Response> replay_exchange(const std::string& method, const std::string& url, const std::string& body) {
+        std::unique_lock<std::mutex> lock(transport_mutex);
+        if (current.mode != TransportMode::Replay) return std::nullopt;
+
+        std::string key_url = redact(url);
+        Interaction* match = nullptr;
+        for (auto& i : interactions) {
+            if (i.method != method || i.url != key_url || i.body != body) continue;
+            match = &i;
+            if (!i.used) break;
+        }
+
+        cpr::Response response;
+        response.url = cpr::Url{url};
+        if (!match) {
+            response.status_code = 0;
+            response.error.code = cpr::ErrorCode::UNKNOWN_ERROR;
+            response.error.message = "no recorded response for " + method + " " + key_url;
+            std::cerr << "⚠️  Replay: " << response.error.message << "\n";
+            return response;
+        }
+        match->used = true;
+        response.status_code = match->status;
+        response.text = match->text;
+        response.elapsed = match->elapsed;
+
+        auto delay = current.latency ? *current.latency
+                                     : std::chrono::milliseconds(static_cast<long long>(match->elapsed * 1000));
+        lock.unlock();
+        if (delay.count() > 0) std::this_thread::sleep_for(delay);
+        return response;
+    }
+
+    void record_exchange(const std::string& method, const std::string& url, const std::string& body,
+                         const cpr::Response& response) {
+        std::lock_guard<std::mutex> lock(transport_mutex);
+        if (current.mode != TransportMode::Record) return;
+        // Connection failures are not worth replaying
+        if (response.status_code == 0) return;
+
+        Interaction i;
+        i.method = method;
+        i.url = redact(url);
+        i.body = body;
+        i.status = response.status_code;
+        i.text = response.text;
+        i.elapsed = response.elapsed;
+        interactions.push_back(std::move(i));
+        save_cassette();
+    }
+}
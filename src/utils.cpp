@@ -1,123 +1,98 @@
 #include "utils.h"
-#include <regex>
+#include "metadata_cache.h"
+#include "config.h"
+#include "request_context.h"
+#include <cstdio>
 #include <fstream>
 #include <filesystem>
 #include <iostream>
 #include <nlohmann/json.hpp>
-#include <cpr/cpr.h>
+#include <random>
 #include <sstream>
+#include <stdexcept>
 
 namespace leetcli {
 
     void set_gemini_key(const std::string& key) {
-        nlohmann::json config;
-        std::filesystem::path path = std::filesystem::path(get_home()) / ".leetcli/config.json";
-
-        // If config already exists, preserve other values
-        if (std::ifstream in(path); in) {
-            in >> config;
+        Config updated = config();
+        updated.gemini_key = key;
+        if (save_config(updated)) {
+            std::cout << "✅ Gemini key saved to " << get_config_path() << "\n";
         }
-
-        config["gemini_key"] = key;
-
-        std::ofstream out(path);
-        out << config.dump(2);
-        std::cout << "✅ Gemini key saved to " << path << "\n";
     }
 
     std::string get_gemini_key() {
-        std::ifstream in(std::filesystem::path(get_home()) / ".leetcli/config.json");
-        if (!in) throw std::runtime_error("No config file found");
-
-        nlohmann::json config;
-        in >> config;
-
-        if (!config.contains("gemini_key")) {
+        const Config& cfg = config();
+        if (cfg.gemini_key.empty()) {
             throw std::runtime_error("Gamini key not set in config");
         }
-
-        return config["gemini_key"];
+        return cfg.gemini_key;
     }
 
-    void fetch_testcases(const std::string& slug, const std::string& folder_path) {
-        std::string session = get_session_cookie();
-        std::string csrf = get_csrf_token();
-
-        // GraphQL query to extract exampleTestcaseList
-        nlohmann::json request_body = {
-            {"operationName", "consolePanelConfig"},
-            {"query", R"(
-            query consolePanelConfig($titleSlug: String!) {
-                question(titleSlug: $titleSlug) {
-                    exampleTestcaseList
-                }
-            })"},
-            {"variables", {{"titleSlug", slug}}}
-        };
-
-        cpr::Response response = cpr::Post(
-            cpr::Url{"https://leetcode.com/graphql"},
-            cpr::Header{
-                {"Content-Type", "application/json"},
-                {"x-csrftoken", csrf},
-                {"Cookie", "LEETCODE_SESSION=" + session + "; csrftoken=" + csrf},
-                {"Referer", "https://leetcode.com/problems/" + slug + "/"}
-            },
-            cpr::Body{request_body.dump()}
-        );
-
-        if (response.status_code != 200) {
-            std::cerr << "❌ Failed to fetch testcases: " << response.status_code << "\n";
-            return;
+    bool write_file_atomic(const std::filesystem::path& path, const std::string& contents) {
+        // Write to a sibling temp file and rename over the target so readers never see half a file.
+        // The CLI, leetclid, prefetch and watch write the same files, so each writer gets its own
+        // temp name; a shared one could be renamed in while another process is still filling it.
+        thread_local std::mt19937_64 rng{std::random_device{}()};
+        char suffix[24];
+        std::snprintf(suffix, sizeof(suffix), ".%016llx.tmp", static_cast<unsigned long long>(rng()));
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        std::filesystem::path tmp = path;
+        tmp += suffix;
+        {
+            std::ofstream out(tmp, std::ios::binary);
+            if (!out) return false;
+            out << contents;
+            if (!out.flush()) return false;
         }
-
-        auto json = nlohmann::json::parse(response.text);
-        auto testcases_json = json["data"]["question"]["exampleTestcaseList"];
-        if (!testcases_json.is_array()) {
-            std::cerr << "❌ No testcases found in response.\n";
-            return;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp, ec);
+            return false;
         }
+        return true;
+    }
 
+    void save_testcases(const std::string& folder_path, const std::vector<std::string>& testcases) {
         // Create file path and directory
         std::filesystem::path dir = folder_path;
         std::filesystem::create_directories(dir);
         std::ofstream outfile(dir / "testcases.txt");
 
-        for (size_t i = 0; i < testcases_json.size(); ++i) {
-            outfile << testcases_json[i].get<std::string>();
-            if (i + 1 != testcases_json.size())
+        for (size_t i = 0; i < testcases.size(); ++i) {
+            outfile << testcases[i];
+            if (i + 1 != testcases.size())
                 outfile << "\n---\n";  // separator between test cases
         }
+    }
 
-        std::cout << "✅ Saved testcases to " << (dir / "testcases.txt") << "\n";
+    void write_problem_json(const std::string& folder_path, const nlohmann::json& question) {
+        std::ofstream out(std::filesystem::path(folder_path) / "problem.json");
+        if (!out) {
+            std::cerr << "Failed to write problem.json in " << folder_path << "\n";
+            return;
+        }
+        out << question.dump(2);
     }
 
-    std::string get_question_id(const std::string& slug, const std::string& session, const std::string& csrf) {
-        nlohmann::json payload = {
-            {"operationName", "getQuestionDetail"},
-            {"query", R"(
-            query getQuestionDetail($titleSlug: String!) {
-                question(titleSlug: $titleSlug) {
-                    questionId
-                }
-            }
-        )"},
-            {"variables", {{"titleSlug", slug}}}
-        };
+    std::optional<nlohmann::json> load_local_problem(const std::string& slug) {
+        // Only consult the metadata cache: a problem that was never fetched has no problem.json anyway
+        auto meta = lookup_question_meta(slug);
+        if (!meta) return std::nullopt;
+
+        std::ifstream in(std::filesystem::path(get_problems_dir()) / meta->folder / "problem.json");
+        if (!in) return std::nullopt;
 
-        cpr::Response r = cpr::Post(
-            cpr::Url{"https://leetcode.com/graphql"},
-            cpr::Header{
-                {"Content-Type", "application/json"},
-                {"x-csrftoken", csrf},
-                {"Cookie", "LEETCODE_SESSION=" + session + "; csrftoken=" + csrf}
-            },
-            cpr::Body{payload.dump()}
-        );
-
-        if (r.status_code != 200) throw std::runtime_error("Failed to get questionId");
-        auto json = nlohmann::json::parse(r.text);
-        return json["data"]["question"]["questionId"];
+        nlohmann::json question = nlohmann::json::parse(in, nullptr, false);
+        if (question.is_discarded() || !question.is_object()) return std::nullopt;
+        return question;
+    }
+
+    std::string get_question_id(const std::string& slug) {
+        QuestionMeta meta;
+        if (resolve_question_meta(slug, meta) != 0) throw std::runtime_error("Failed to get questionId");
+        return meta.question_id;
     }
 
     std::string get_file_extension(const std::string& filename) {
@@ -128,7 +103,18 @@ namespace leetcli {
         return filename.substr(dot_pos + 1);
     }
 
-    static std::filesystem::path get_home() {
+    std::string hash_hex(const std::string& data) {
+        uint64_t h = 1469598103934665603ULL;
+        for (unsigned char c : data) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        char buf[17];
+        std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(h));
+        return buf;
+    }
+
+    std::filesystem::path get_home() {
         if (auto *h = std::getenv("HOME"); h && *h) return h;
         if (auto *u = std::getenv("USERPROFILE"); u && *u) return u;
         std::cerr << "Fatal: cannot determine home directory.\n";
@@ -136,38 +122,23 @@ namespace leetcli {
     }
 
     std::string get_preferred_language() {
-        std::filesystem::path config_path = std::filesystem::path(get_home()) / ".leetcli/config.json";
-        if (!std::filesystem::exists(config_path)) {
-            std::cerr << "Error: config not found. Run `leetcli init` first.\n";
-            std::exit(1);
-        }
-
-        std::ifstream in(config_path);
-        nlohmann::json config;
-        in >> config;
-        return config.value("lang", "cpp"); // fallback to cpp
+        return config().lang;
     }
 
 
     std::string get_problems_dir() {
-        std::filesystem::path config_path = get_home() / ".leetcli/config.json";
-        if (!std::filesystem::exists(config_path)) {
-            std::cerr << "Error:  not found. Run `leetcli init` first.\n";
-            std::exit(1);
-        }
+        // A relative problems_dir is relative to where the command was started, even inside leetclid
+        return resolve_path(config().problems_dir).string();
+    }
 
-        std::ifstream in(config_path);
-        nlohmann::json config;
-        in >> config;
-        return config["problems_dir"];
+    std::filesystem::path get_workspace_state_dir() {
+        return std::filesystem::path(get_problems_dir()) / ".leetcli";
     }
 
     void init_problems_folder() {
-        std::filesystem::path home = get_home();
-        std::filesystem::path config_dir = home / ".leetcli";
-        std::filesystem::path config_path = config_dir / "config.json";
+        std::filesystem::path config_path = get_config_path();
 
-        if (std::filesystem::exists(config_path)) {
+        if (config_exists()) {
             std::cerr << "leetcli is already initialized.\n";
             std::cerr << "To reset: delete " << config_path << "\n";
             return;
@@ -175,61 +146,26 @@ namespace leetcli {
 
         // Create config and problems dir
         std::string default_path = std::filesystem::current_path().string() + "/problems/";
-        std::filesystem::create_directories(config_dir);
         std::filesystem::create_directories(default_path);
 
         // Ask for preferred language
         std::string lang;
         std::cout << "Enter your preferred language (e.g., cpp, python, java): ";
         std::getline(std::cin, lang);
-        if (lang != "python" && lang != "cpp" && lang != "java") {
+        if (!find_language(lang)) {
             std::cout << "Language is not supported";
             return;
         }
-        nlohmann::json config = {
-            {"problems_dir", default_path},
-            {"lang", lang}
-        };
-
-        std::ofstream out(config_path);
-        if (!out) {
-            std::cerr << "Failed to write config: " << config_path << "\n";
+        Config cfg;
+        cfg.problems_dir = default_path;
+        cfg.lang = lang;
+        if (!save_config(cfg)) {
             return;
         }
 
-        out << config.dump(4);
         std::cout << "leetcli initialized.\nProblems will be saved to:\n  " << default_path << "\n";
     }
 
-    std::string html_to_text(const std::string &html) {
-        std::string text = html;
-        text = std::regex_replace(text, std::regex("<h1[^>]*>"), "# ");
-        text = std::regex_replace(text, std::regex("<h2[^>]*>"), "## ");
-        text = std::regex_replace(text, std::regex("</h[1-6]>"), "\n");
-        text = std::regex_replace(text, std::regex("<p[^>]*>"), "\n");
-        text = std::regex_replace(text, std::regex("</p>"), "\n");
-        text = std::regex_replace(text, std::regex("<br[^>]*>"), "\n");
-        text = std::regex_replace(text, std::regex("<li[^>]*>"), " - ");
-        text = std::regex_replace(text, std::regex("</li>"), "\n");
-        text = std::regex_replace(text, std::regex("<pre[^>]*><code[^>]*>"), "```\n");
-        text = std::regex_replace(text, std::regex("</code></pre>"), "\n```");
-        text = std::regex_replace(text, std::regex("<code[^>]*>"), "`");
-        text = std::regex_replace(text, std::regex("</code>"), "`");
-        text = std::regex_replace(text, std::regex("<b[^>]*>"), "**");
-        text = std::regex_replace(text, std::regex("</b>"), "**");
-        text = std::regex_replace(text, std::regex("<strong[^>]*>"), "**");
-        text = std::regex_replace(text, std::regex("</strong>"), "**");
-        text = std::regex_replace(text, std::regex("<[^>]*>"), "");
-
-        text = std::regex_replace(text, std::regex("&nbsp;"), " ");
-        text = std::regex_replace(text, std::regex("&lt;"), "<");
-        text = std::regex_replace(text, std::regex("&gt;"), ">");
-        text = std::regex_replace(text, std::regex("&amp;"), "&");
-        text = std::regex_replace(text, std::regex("&quot;"), "\"");
-
-        return text;
-    }
-
     void write_markdown_file(const std::string &path, const std::string &title, const std::string &markdown) {
         std::ofstream out(path);
         if (!out) {
@@ -272,16 +208,7 @@ namespace leetcli {
     }
 
     void set_session_cookie() {
-        std::filesystem::path config_path = get_home() / ".leetcli/config.json";
-
-        if (!std::filesystem::exists(config_path)) {
-            std::cerr << "Run `leetcli init` first.\n";
-            std::exit(1);
-        }
-
-        std::ifstream in(config_path);
-        nlohmann::json config;
-        in >> config;
+        Config updated = config();
 
         std::string session, csrf;
         std::cout << "Paste your LEETCODE_SESSION cookie (Dev Tools -> Application -> Cookies):\n> ";
@@ -289,124 +216,93 @@ namespace leetcli {
         std::cout << "Paste your csrftoken cookie (Dev Tools -> Application -> Cookies):\n> ";
         std::getline(std::cin, csrf);
 
-        config["leetcode_session"] = session;
-        config["csrf_token"] = csrf;
+        updated.leetcode_session = session;
+        updated.csrf_token = csrf;
 
-        std::ofstream out(config_path);
-        out << config.dump(4);
-        std::cout << "Session & CSRF token saved.\n";
+        if (save_config(updated)) {
+            std::cout << "Session & CSRF token saved.\n";
+        }
     }
 
     std::string get_session_cookie() {
-        std::filesystem::path config_path = get_home() / ".leetcli/config.json";
-
-        if (!std::filesystem::exists(config_path)) {
-            std::cerr << "Error: config not found. Run `leetcli init` first.\n";
-            std::exit(1);
+        const Config& cfg = config();
+        if (cfg.leetcode_session.empty()) {
+            throw std::runtime_error("No session cookie set. Run `leetcli login`.");
         }
-
-        std::ifstream in(config_path);
-        nlohmann::json config;
-        in >> config;
-
-        if (!config.contains("leetcode_session")) {
-            std::cerr << "Error: No session cookie set. Run `leetcli login`.\n";
-            std::exit(1);
-        }
-
-        return config["leetcode_session"];
+        return cfg.leetcode_session;
     }
 
     std::string get_csrf_token() {
-        std::filesystem::path config_path = get_home() / ".leetcli/config.json";
-
-        std::ifstream in(config_path);
-        nlohmann::json config;
-        in >> config;
-
-        if (!config.contains("csrf_token")) {
-            std::cerr << "No CSRF token found. Run `leetcli login`.\n";
-            std::exit(1);
+        const Config& cfg = config();
+        if (cfg.csrf_token.empty()) {
+            throw std::runtime_error("No CSRF token found. Run `leetcli login`.");
         }
-
-        return config["csrf_token"];
+        return cfg.csrf_token;
     }
 
     int get_solution_folder(const std::string &slug, std::string &folder_path) {
-        // Step 1: Query LeetCode to get the ID and Title
-        nlohmann::json query = {
-            {
-                "query", R"(
-            query getQuestionDetail($titleSlug: String!) {
-                question(titleSlug: $titleSlug) {
-                    title
-                    questionId
-                }
-            }
-        )"
-            },
-            {"variables", {{"titleSlug", slug}}}
-        };
-
-        cpr::Response r = cpr::Post(
-            cpr::Url{"https://leetcode.com/graphql"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{query.dump()}
-        );
-
-        if (r.status_code != 200) {
-            std::cerr << "Failed to query problem info.\n";
+        // Step 1: Look up the ID and Title (cached after the first fetch)
+        QuestionMeta meta;
+        if (resolve_question_meta(slug, meta) != 0) {
             return 1;
         }
 
-        auto json = nlohmann::json::parse(r.text);
-        auto question = json["data"]["question"];
-        std::string id = question["questionId"];
-        std::string title = question["title"];
-        std::string safe_title = std::regex_replace(title, std::regex("[\\\\/:*?\"<>|]"), "");
-
         // Step 2: Build the folder path
-        std::string folder = get_problems_dir() + "/" + id + ". " + safe_title;
-
-        folder_path = folder;
+        folder_path = get_problems_dir() + "/" + meta.folder;
         return 0;
     }
 
-    int get_solution_filepath(const std::string &slug, std::string &solution_file, const std::optional<std::string> &language) {
-        // Step 1: Query LeetCode to get the ID and Title
-        nlohmann::json query = {
-            {
-                "query", R"(
-                    query getQuestionDetail($titleSlug: String!) {
-                        question(titleSlug: $titleSlug) {
-                            title
-                            questionId
-                        }
-                    }
-                )"
-            },
-            {"variables", {{"titleSlug", slug}}}
+    const std::vector<Language>& supported_languages() {
+        static const std::vector<Language> languages = {
+            {"cpp", ".cpp", "cpp"},
+            {"python", ".py", "python3"},
+            {"python3", ".py", "python3"},
+            {"java", ".java", "java"},
+            {"javascript", ".js", "javascript"},
+            {"typescript", ".ts", "typescript"},
+            {"csharp", ".cs", "csharp"},
+            {"c", ".c", "c"},
+            {"golang", ".go", "golang"},
+            {"rust", ".rs", "rust"},
+            {"kotlin", ".kt", "kotlin"},
+            {"swift", ".swift", "swift"},
+            {"ruby", ".rb", "ruby"},
+            {"scala", ".scala", "scala"},
+            {"php", ".php", "php"},
+            {"dart", ".dart", "dart"}
         };
+        return languages;
+    }
 
-        cpr::Response r = cpr::Post(
-            cpr::Url{"https://leetcode.com/graphql"},
-            cpr::Header{{"Content-Type", "application/json"}},
-            cpr::Body{query.dump()}
-        );
+    const Language* find_language(const std::string& name) {
+        for (const auto& lang : supported_languages()) {
+            if (lang.name == name) return &lang;
+        }
+        return nullptr;
+    }
 
-        if (r.status_code != 200) {
-            std::cerr << "Failed to query problem info.\n";
-            return 1;
+    const Language* language_for_extension(const std::string& extension) {
+        for (const auto& lang : supported_languages()) {
+            if (lang.extension == extension) return &lang;
         }
+        return nullptr;
+    }
+
+    std::optional<std::string> solution_extension(const std::string& lang) {
+        const Language* found = find_language(lang);
+        if (!found) return std::nullopt;
+        return found->extension;
+    }
 
-        auto json = nlohmann::json::parse(r.text);
-        auto question = json["data"]["question"];
-        std::string id = question["questionId"];
-        std::string title = question["title"];
-        std::string safe_title = std::regex_replace(title, std::regex("[\\\\/:*?\"<>|]"), "");
+    int get_solution_filepath(const std::string &slug, std::string &solution_file, const std::optional<std::string> &language) {
+        // Step 1: Look up the ID and Title (cached after the first fetch)
+        QuestionMeta meta;
+        if (resolve_question_meta(slug, meta) != 0) {
+            return 1;
+        }
 
         // Step 2: Build the folder path
-        std::string folder = get_problems_dir() + "/" + id + ". " + safe_title;
+        std::string folder = get_problems_dir() + "/" + meta.folder;
 
         if (!std::filesystem::exists(folder)) {
             std::cerr << "Folder not found. Run: leetcli fetch " << slug << "\n";
@@ -414,36 +310,19 @@ namespace leetcli {
         }
 
         // Step 3: Map supported languages to file extensions
-        std::map<std::string, std::string> lang_to_ext = {
-            {"cpp", ".cpp"},
-            {"python", ".py"},
-            {"java", ".java"},
-            {"javascript", ".js"},
-            {"csharp", ".cs"}
-        };
-
         std::string lang;
         if (language.has_value()) {
             lang = language.value();
         } else {
-            // Load config to get default language
-            std::filesystem::path config_path = std::filesystem::path(get_home()) / ".leetcli/config.json";
-            std::ifstream in(config_path);
-            if (!in) {
-                std::cerr << "Could not read config file at " << config_path << "\n";
-                return 1;
-            }
-            nlohmann::json config;
-            in >> config;
-            lang = config["lang"];
+            lang = get_preferred_language();
         }
-        if (lang_to_ext.find(lang) == lang_to_ext.end()) {
+        auto ext = solution_extension(lang);
+        if (!ext) {
             std::cerr << "Unsupported language: " << lang << "\n";
             return 1;
         }
 
-        std::string ext = lang_to_ext[lang];
-        std::filesystem::path candidate = folder + "/solution" + ext;
+        std::filesystem::path candidate = folder + "/solution" + *ext;
 
         if (!std::filesystem::exists(candidate)) {
             std::cerr << "Solution file not found for language '" << lang << "' in: " << candidate << "\n";
@@ -0,0 +1,298 @@
+#include "watch.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <csignal>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace leetcli {
+
+    namespace {
+        volatile std::sig_atomic_t stop_requested = 0;
+
+        void on_sigint(int) {
+            stop_requested = 1;
+        }
+
+        std::string clock_time() {
+            std::time_t now = std::time(nullptr);
+            std::tm tm{};
+#ifdef _WIN32
+            localtime_s(&tm, &now);
+#else
+            localtime_r(&now, &tm);
+#endif
+            char buf[16];
+            std::strftime(buf, sizeof(buf), "%H:%M:%S", &tm);
+            return buf;
+        }
+
+        std::string read_file(const std::string& path) {
+            std::ifstream in(path, std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        }
+
+        // First few lines of a long compiler or runtime message
+        std::string head_lines(const std::string& text, size_t max_lines) {
+            std::istringstream in(text);
+            std::string line, out;
+            size_t n = 0;
+            while (std::getline(in, line)) {
+                if (n++ == max_lines) {
+                    out += "  ...\n";
+                    break;
+                }
+                out += "  " + line + "\n";
+            }
+            return out;
+        }
+
+        // One status line, then +/- lines for what changed since the previous run
+        void print_compact(const RunReport& report, const RunReport* previous, std::chrono::milliseconds took) {
+            std::cout << "[" << clock_time() << "] ";
+
+            if (!report.compile_error.empty()) {
+                std::cout << "⛔ Compile Error (" << took.count() << " ms)\n" << head_lines(report.compile_error, 12);
+                return;
+            }
+            if (!report.ok) {
+                std::cout << "⛔ " << report.status_msg << " (" << took.count() << " ms)\n";
+                if (!report.runtime_error.empty()) std::cout << head_lines(report.runtime_error, 8);
+                return;
+            }
+
+            size_t passed = 0, judged = 0;
+            for (const auto& row : report.cases) {
+                if (!row.judged) continue;
+                ++judged;
+                if (row.passed) ++passed;
+            }
+            bool all_passed = passed == judged;
+            std::cout << (all_passed ? "✅ " : "❌ ") << passed << "/" << judged << " passed";
+            if (judged < report.cases.size()) std::cout << ", " << (report.cases.size() - judged) << " unjudged";
+            std::cout << " · " << report.runtime << " · " << took.count() << " ms" << (report.cached ? " (cached)" : "") << "\n";
+
+            bool comparable = previous && previous->ok && previous->cases.size() == report.cases.size();
+            for (size_t i = 0; i < report.cases.size(); ++i) {
+                const auto& row = report.cases[i];
+                bool was_passing = comparable && previous->cases[i].judged && previous->cases[i].passed;
+                if (!row.judged) {
+                    std::cout << "? case " << (i + 1) << "  " << row.input << "  → " << row.output << "\n";
+                } else if (!row.passed) {
+                    std::cout << "- case " << (i + 1) << (was_passing ? " (broke)" : "") << "  " << row.input << "\n"
+                              << "    got      " << row.output << "\n"
+                              << "    expected " << row.expected << "\n";
+                } else if (comparable && !was_passing) {
+                    std::cout << "+ case " << (i + 1) << " passes now\n";
+                }
+            }
+        }
+
+        // Runs land on one long-lived thread so its HTTP client (and login) is reused
+        class RunWorker {
+        public:
+            RunWorker(std::string slug, std::string lang, RunOptions options)
+                : slug_(std::move(slug)), lang_(std::move(lang)), options_(options) {
+                options_.quiet = true;
+                options_.cancel = &cancel_;
+                thread_ = std::thread([this] { loop(); });
+            }
+
+            ~RunWorker() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                    cancel_ = true;
+                }
+                cv_.notify_all();
+                thread_.join();
+            }
+
+            // Cancels whatever is running and queues a fresh run. Returns true if one was cut short.
+            bool request() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++requested_;
+                bool was_running = busy_;
+                cancel_ = true;
+                cv_.notify_all();
+                return was_running;
+            }
+
+        private:
+            void loop() {
+                std::unique_ptr<RunReport> previous;
+                while (true) {
+                    uint64_t generation;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        cv_.wait(lock, [&] { return stop_ || requested_ != done_; });
+                        if (stop_) return;
+                        generation = requested_;
+                        cancel_ = false;
+                        busy_ = true;
+                    }
+
+                    const auto start = std::chrono::steady_clock::now();
+                    RunReport report;
+                    // A lost session or a bad reply fails this run, not the whole watch
+                    try {
+                        report = run_tests(slug_, lang_, options_);
+                    } catch (const std::exception& e) {
+                        report.ok = false;
+                        report.status_msg = std::string("Error: ") + e.what();
+                    } catch (...) {
+                        report.ok = false;
+                        report.status_msg = "Error: unexpected failure";
+                    }
+                    auto took = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    busy_ = false;
+                    done_ = generation;
+                    // A newer save already superseded this run
+                    if (stop_ || cancel_ || requested_ != generation) continue;
+                    print_compact(report, previous.get(), took);
+                    std::cout << std::flush;
+                    if (report.ok) previous = std::make_unique<RunReport>(std::move(report));
+                }
+            }
+
+            std::string slug_;
+            std::string lang_;
+            RunOptions options_;
+            std::atomic<bool> cancel_{false};
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            uint64_t requested_ = 0;
+            uint64_t done_ = 0;
+            bool busy_ = false;
+            bool stop_ = false;
+            std::thread thread_;
+        };
+
+        // Blocks until the file may have changed (or Ctrl-C). Uses inotify on the folder, since
+        // editors often save by writing a new file and renaming it over the old one.
+        class FileWatcher {
+        public:
+            explicit FileWatcher(const std::filesystem::path& file) : file_(file) {
+#ifdef __linux__
+                fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (fd_ >= 0 && inotify_add_watch(fd_, file.parent_path().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+                    close(fd_);
+                    fd_ = -1;
+                }
+#endif
+                last_stamp_ = stamp();
+            }
+
+            ~FileWatcher() {
+#ifdef __linux__
+                if (fd_ >= 0) close(fd_);
+#endif
+            }
+
+            FileWatcher(const FileWatcher&) = delete;
+            FileWatcher& operator=(const FileWatcher&) = delete;
+
+            bool using_inotify() const { return fd_ >= 0; }
+
+            // Waits up to timeout for an event on the watched file
+            bool wait(std::chrono::milliseconds timeout) {
+#ifdef __linux__
+                if (fd_ >= 0) {
+                    pollfd pfd{fd_, POLLIN, 0};
+                    if (poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0) return false;
+                    alignas(inotify_event) char buf[4096];
+                    bool hit = false;
+                    ssize_t len;
+                    while ((len = read(fd_, buf, sizeof(buf))) > 0) {
+                        for (char* p = buf; p < buf + len;) {
+                            auto* event = reinterpret_cast<inotify_event*>(p);
+                            if (event->len && file_.filename() == event->name) hit = true;
+                            p += sizeof(inotify_event) + event->len;
+                        }
+                    }
+                    return hit;
+                }
+#endif
+                // No inotify: compare mtime and size a few times a second
+                const auto until = std::chrono::steady_clock::now() + timeout;
+                while (!stop_requested && std::chrono::steady_clock::now() < until) {
+                    auto now = stamp();
+                    if (now != last_stamp_) {
+                        last_stamp_ = now;
+                        return true;
+                    }
+                    std::this_thread::sleep_for(std::min(timeout, std::chrono::milliseconds(250)));
+                }
+                return false;
+            }
+
+        private:
+            std::pair<int64_t, uintmax_t> stamp() const {
+                std::error_code ec;
+                auto mtime = std::filesystem::last_write_time(file_, ec);
+                int64_t t = ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
+                uintmax_t size = std::filesystem::file_size(file_, ec);
+                return {t, ec ? 0 : size};
+            }
+
+            std::filesystem::path file_;
+            int fd_ = -1;
+            std::pair<int64_t, uintmax_t> last_stamp_;
+        };
+    }
+
+    int watch_solution(const std::string& slug, const std::string& lang_override, const WatchOptions& options) {
+        std::string solution_path;
+        int status = lang_override.empty() ? get_solution_filepath(slug, solution_path)
+                                           : get_solution_filepath(slug, solution_path, lang_override);
+        if (status != 0) return 1;
+
+        FileWatcher watcher(solution_path);
+        std::cout << "👀 Watching " << solution_path << (watcher.using_inotify() ? "" : " (polling)")
+                  << "; Ctrl-C to stop.\n";
+
+        stop_requested = 0;
+        auto previous_handler = std::signal(SIGINT, on_sigint);
+        {
+            RunWorker worker(slug, lang_override, options.run);
+            std::string last_hash = hash_hex(read_file(solution_path));
+            worker.request();
+
+            while (!stop_requested) {
+                if (!watcher.wait(std::chrono::milliseconds(500))) continue;
+
+                // Editors often write a file in several steps; wait for them to settle
+                while (!stop_requested && watcher.wait(options.debounce)) {}
+                if (stop_requested) break;
+
+                // Saving without changes doesn't need a run
+                std::string hash = hash_hex(read_file(solution_path));
+                if (hash == last_hash) continue;
+                last_hash = hash;
+
+                if (worker.request()) {
+                    std::cout << "[" << clock_time() << "] ↻ Saved again, restarting run\n" << std::flush;
+                }
+            }
+        }
+        std::signal(SIGINT, previous_handler == SIG_ERR ? SIG_DFL : previous_handler);
+        std::cout << "\n👋 Stopped watching.\n";
+        return 0;
+    }
+}